@@ -0,0 +1,30 @@
+-- image_asynch_status
+-- @short: Retrieve counters for the asynchronous image loader
+-- @inargs:
+-- @outargs: statustbl
+-- @longdescr: Asynchronous image loads (see ref:load_image_asynch) are
+-- queued to a pool of worker threads that is grown on demand. This function
+-- returns a table with the current state of that pool, which can be used to
+-- tune how aggressively an appl issues asynchronous loads.
+-- The fields are: *workers* (number of spawned loader threads), *queued*
+-- (jobs waiting for a worker), *prioritized* (queued jobs that were moved
+-- ahead because their object became visible), *running* (jobs currently
+-- being decoded), *completed* (total finished jobs), *cancelled* (jobs that
+-- were dropped because the object was deleted before loading started),
+-- *latency_avg* and *latency_max* (milliseconds from the job being queued
+-- until the image was decoded).
+-- @note: Jobs for objects with an opacity above zero are moved to the front
+-- of the queue, so showing an object that is still loading will make it
+-- arrive sooner.
+-- @group: image
+-- @cfunction: imageasynchstatus
+-- @related: load_image_asynch, image_pushasynch
+function main()
+#ifdef MAIN
+	for i=1,10 do
+		load_image_asynch("test.png");
+	end
+	local tbl = image_asynch_status();
+	print(tbl.workers, tbl.queued, tbl.latency_avg);
+#endif
+end
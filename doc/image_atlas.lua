@@ -0,0 +1,44 @@
+-- image_atlas
+-- @short: Pack the storage of a small image into a shared texture atlas.
+-- @inargs: vid, *state*
+-- @outargs: bool
+-- @longdescr: Every video object normally has a backing store of its own,
+-- and with it a texture in the graphics layer. For appls that use many small
+-- static images, like icons or decorations, the cost of switching between all
+-- those textures when drawing can dominate. This function moves the backing
+-- store of *vid* into one of a set of larger textures (pages) that are shared
+-- between all objects in the context that have been packed this way, and
+-- changes its texture coordinates to match. Objects that share a page and a
+-- shader can then be drawn together.
+-- If *state* is set to false, the object gets a store of its own again.
+-- The function returns true if the object is in the requested state.
+-- @note: Only objects with a textured, unshared store that is at most
+-- 128x128 pixels, not set to repeat, not mipmapped, not used by a frameserver
+-- and with a local copy of its contents can be packed. This also means that
+-- it is not possible in memory conservative mode.
+-- @note: ref:image_set_txcos and ref:image_get_txcos work relative to the
+-- original store. Coordinates outside of 0..1, as well as operations that
+-- need the store to be its own (sharing, resizing, framesets, changing filter
+-- or texture mode, accessing the storage) move the object out of the page
+-- first.
+-- @note: Custom shaders will see the page dimensions as the storage size.
+-- @note: Space left when packed objects are deleted is reclaimed by
+-- repacking the page, which means that the texture coordinates of other
+-- objects in it may change.
+-- @group: image
+-- @cfunction: imageatlas
+-- @related: image_mipmap
+function main()
+#ifdef MAIN
+	for i=1,64 do
+		local img = fill_surface(32, 32, math.random(255), 0, 0);
+		image_atlas(img);
+		move_image(img, (i % 8) * 32, math.floor(i / 8) * 32);
+		show_image(img);
+	end
+#endif
+
+#ifdef ERROR
+	image_atlas(BADID);
+#endif
+end
@@ -0,0 +1,42 @@
+-- input_batching
+-- @short: Tune how input events are queued for the input_batch entry point
+-- @inargs: *limit*, *coalesce*
+-- @outargs: limit
+-- @longdescr: If the appl implements the applname_input_batch(events, count)
+-- entry point, input events are queued instead of being sent one at a time
+-- to applname_input. The queue is delivered when it reaches *limit* events
+-- (default 64, max 256), before applname_input_end, and before any other
+-- kind of event so that ordering is kept.
+-- If *coalesce* is set (default, false), consecutive motion samples (analog
+-- and touch) from the same device and axis are merged into the earlier queued
+-- one, as long as no other kind of input event came in between. Relative
+-- samples are summed and absolute ones are set to the latest value. A merged
+-- event gets a 'coalesced' field with the number of samples that were folded
+-- into it.
+-- The returned limit is the one that was applied after clamping.
+-- @note: The events table and the tables inside it are reused between calls
+-- to avoid garbage, entries past *count* are stale and should be ignored.
+-- @note: Out-of-loop events delivered through applname_input_raw are not
+-- queued. While there are queued events that have not been delivered yet,
+-- input_raw is not called and the event is deferred to the normal loop
+-- instead so that it can't overtake them.
+-- @group: iodev
+-- @cfunction: inputbatching
+-- @related: input_samplebase
+function main()
+#ifdef MAIN
+	input_batching(32, true);
+	main_input_batch = function(events, count)
+		for i=1,count do
+			local ev = events[i];
+			if ev.mouse and ev.analog then
+				print(ev.subid, ev.samples[1], ev.coalesced or 0);
+			end
+		end
+	end
+#endif
+
+#ifdef ERROR1
+	input_batching("potatoe", "potatoe");
+#endif
+end
@@ -17,6 +17,11 @@
 -- *int:dirty* - how many times the dirty counter has been incremented since last render pass.
 -- *int:transfers* - the number of external uploads since last render pass.
 -- *int:updates* - the number of ongoing transforms.
+-- *int:draw_calls* - the number of 2D draw calls issued during the last render pass.
+-- *int:batched* - the number of objects in the last render pass that were merged
+-- into a shared draw call rather than drawn on their own.
+-- *int:culled* - the number of objects in the last render pass that were
+-- skipped as they were covered by an opaque object, see rendertarget_occlusion.
 -- *int:time_move* - the relative clock of the last move transform.
 -- *int:time_scale* - the relative clock of the last scale transform.
 -- *int:time_rotate* - the relative clock of the last rotate transform.
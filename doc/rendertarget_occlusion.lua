@@ -0,0 +1,35 @@
+-- rendertarget_occlusion
+-- @short: Enable / Disable skipping objects that are hidden behind opaque ones.
+-- @inargs: vid, cull
+-- @outargs: success
+-- @longdescr: By default, every visible object attached to a rendertarget
+-- is drawn, even if something opaque will be drawn on top of it later in
+-- the same pass. For dense scenes, e.g. stacks of fullscreen windows, this
+-- wastes fill rate. Setting a true value to a vid that is connected to a
+-- rendertarget enables an extra pass that finds opaque objects and skips
+-- drawing objects that are fully covered by one of them.
+-- An object counts as opaque if it has full opacity, a blend mode that
+-- resolves to no blending, the default shader, no clipping and no rotation.
+-- @note: Setting WORLDID as vid will change the behavior for the
+-- standard output rendertarget.
+-- @note: Objects with a custom shader are never culled, as their vertex
+-- stage may move them outside of their regular bounds.
+-- @note: Only the largest few opaque objects in each pass are considered,
+-- the number of skipped objects is reported as 'culled' by
+-- ref:rendertarget_metrics.
+-- @group: targetcontrol
+-- @cfunction: renderocclusion
+function main()
+#ifdef MAIN
+	rendertarget_occlusion(WORLDID, true);
+	local a = color_surface(64, 64, 255, 0, 0);
+	local b = color_surface(128, 128, 0, 255, 0);
+	show_image({a, b});
+	move_image(a, 32, 32);
+	order_image(b, 2);
+#endif
+
+#ifdef ERROR
+	rendertarget_occlusion(BADID, "potatoe");
+#endif
+end
@@ -0,0 +1,46 @@
+-- target_pacing
+-- @short: Retrieve frame pacing statistics for a frameserver
+-- @inargs: vid:tgtvid, *bool:reset*
+-- @outargs: table
+-- @longdescr: This function is used to find out which client is costing the
+-- most in terms of frame budget or latency without attaching a profiler. The
+-- statistics are gathered continuously for all frameservers and are cleared
+-- after being retrieved if *reset* is set to true (default, false).
+--
+-- The fields in the returned table are:
+-- *int:frames* - the number of frames that have been received.
+-- *int:dropped* - the number of frames that were uploaded but replaced before
+-- any display synch used them, or for output segments, frames that could not
+-- be delivered as the client was still busy with the previous one.
+-- *int:underruns* - the number of times an audio stream that had been
+-- delivering ran dry.
+-- *int:bucket_base* - the base width of the first histogram bucket in
+-- microseconds.
+-- *table:interval* - time between two consecutive uploads.
+-- *table:upload* - time spent uploading the buffer.
+-- *table:latency* - time from the frame first being seen as ready until
+-- the display synch that presented it had finished.
+--
+-- Each histogram table has the fields *count*, *mean* and *max* (in
+-- microseconds) and *buckets*, an indexed table where the value at index n
+-- covers samples in the range [2^(n-1), 2^n) * bucket_base. The first bucket
+-- also covers all samples below that, and the last all samples above.
+-- @group: targetcontrol
+-- @cfunction: targetpacing
+-- @related: target_verbose
+function main()
+#ifdef MAIN
+	local vid = launch_avfeed("", "avfeed",
+	function(source, status)
+		if status.kind == "frame" then
+			local tbl = target_pacing(source, true)
+			print("latency", tbl.latency.mean, tbl.latency.max)
+		end
+	end)
+	target_verbose(vid)
+#endif
+
+#ifdef ERROR1
+	target_pacing(WORLDID)
+#endif
+end
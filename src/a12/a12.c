@@ -23,6 +23,7 @@
 
 #include "a12_decode.h"
 #include "a12_encode.h"
+#include "a12_adpcm.h"
 #include "arcan_mem.h"
 #include "external/chacha.c"
 #include "external/x25519.h"
@@ -289,6 +290,9 @@ static void send_hello_packet(struct a12_state* S,
 		return;
 	}
 
+/* decoding features we support, the other side picks encodings from these */
+	outb[71] = HELLO_FEATURES;
+
 /* channel-id is empty */
 	outb[17] = COMMAND_HELLO;
 	outb[18] = ASHMIF_VERSION_MAJOR;
@@ -325,17 +329,106 @@ static void send_hello_packet(struct a12_state* S,
  * counter as part of the message, replay attacks won't work BUT any
  * reordering would then still need to account for rekeying.
  */
-void a12int_append_out(struct a12_state* S, uint8_t type,
+static size_t seal_packet(struct a12_state* S, uint8_t* dst, uint8_t type,
 	const uint8_t* const out, size_t out_sz, uint8_t* prepend, size_t prepend_sz)
 {
-	if (S->state == STATE_BROKEN)
-		return;
+/* reserve space for the MAC at the start of the packet */
+	size_t pos = MAC_BLOCK_SZ;
+	size_t data_pos = pos;
 
 /*
- * QUEUE-slot here,
- * should also have the ability to probe the size of the queue slots
- * so that encoders can react on backpressure
+ * If we are the client and haven't sent the first authentication request
+ * yet, setup the nonce part of the cipher to random and shorten the MAC.
+ *
+ * Thus the first packet has a half-length MAC and use the other half to
+ * provide the nonce. This is mainly to reduce code complexity somewhat
+ * and not have a different pre-header length for the first packet.
  */
+	size_t mac_sz = MAC_BLOCK_SZ;
+	if (S->authentic != AUTH_FULL_PK && !S->server && !S->cl_firstout){
+		mac_sz >>= 1;
+		arcan_random(&dst[mac_sz], mac_sz);
+		S->cl_firstout = true;
+
+		chacha_set_nonce(S->dec_state, &dst[mac_sz]);
+		chacha_set_nonce(S->enc_state, &dst[mac_sz]);
+		a12int_trace(A12_TRACE_CRYPTO, "kind=cipher:status=init_nonce");
+
+		trace_crypto_key(S->server, "nonce", &dst[mac_sz], mac_sz);
+/* don't forget to add the nonce to the first message MAC */
+		blake3_hasher_update(&S->out_mac, &dst[mac_sz], mac_sz);
+	}
+
+/* 8 byte sequence number */
+	pack_u64(S->current_seqnr++, &dst[pos]);
+	pos += 8;
+
+/* 1 byte command data */
+	dst[pos++] = type;
+
+/* any possible prepend-to-data block, held back packets already have it and
+ * the data block in place */
+	if (prepend_sz){
+		if (prepend != &dst[pos])
+			memcpy(&dst[pos], prepend, prepend_sz);
+		pos += prepend_sz;
+	}
+
+/* apply stream-cipher to the header contents - ETM, and update MAC */
+	chacha_apply(S->enc_state, &dst[data_pos], pos - data_pos);
+	blake3_hasher_update(&S->out_mac, &dst[data_pos], pos - data_pos);
+
+/* and our data block, ciphered while copying (or in place) and then added to
+ * the MAC in chunks small enough to still be in cache, so that large video /
+ * blob payloads only take one trip through memory */
+	for (size_t ofs = 0; ofs < out_sz; ofs += APPEND_CHUNK_SZ){
+		size_t nb = out_sz - ofs > APPEND_CHUNK_SZ ? APPEND_CHUNK_SZ : out_sz - ofs;
+		chacha_apply_copy(S->enc_state, &dst[pos], &out[ofs], nb);
+		blake3_hasher_update(&S->out_mac, &dst[pos], nb);
+		pos += nb;
+	}
+
+/* sample MAC and write to buffer pos, remember it for debugging - no need to
+ * chain separately as 'finalize' is not really finalized */
+	blake3_hasher_finalize(&S->out_mac, dst, mac_sz);
+	a12int_trace(A12_TRACE_CRYPTO, "kind=mac_enc:position=%zu", S->out_mac.counter);
+	trace_crypto_key(S->server, "mac_enc", dst, mac_sz);
+
+	S->stats.b_out += out_sz + prepend_sz;
+	return pos;
+}
+
+/*
+ * Run after a packet has been sealed, issue a rekey if we are the side that
+ * drives it and the byte counter has been exceeded.
+ */
+static void check_rekey(struct a12_state* S, size_t sz)
+{
+	if (S->keys.own_rekey &&
+		(!S->server || (S->server && S->keys.rekey_base_count))){
+
+/* Is the byte counter covered? */
+		if (S->keys.rekey_base_count){
+			if (S->keys.rekey_count > sz){
+				S->keys.rekey_count -= sz;
+				return;
+			}
+		}
+
+		S->keys.rekey_count = S->keys.rekey_base_count;
+
+/* the rekey must go out right after the packet that triggered it regardless
+ * of which class that packet belonged to */
+		int old_class = S->out_class;
+		S->out_class = OUTQ_CONTROL;
+		a12int_issue_rekey(S);
+		S->out_class = old_class;
+	}
+}
+
+static void append_cipher(struct a12_state* S, uint8_t type,
+	const uint8_t* const out, size_t out_sz, uint8_t* prepend, size_t prepend_sz)
+{
 	a12int_trace(A12_TRACE_CRYPTO,
 		"type=%d:size=%zu:prepend_size=%zu:ofs=%zu", type, out_sz, prepend_sz, S->buf_ofs);
 
@@ -359,95 +452,165 @@ void a12int_append_out(struct a12_state* S, uint8_t type,
 	}
 	uint8_t* dst = S->bufs[S->buf_ind];
 
-/* reserve space for the MAC and remember where it starts and ends */
-	size_t mac_pos = S->buf_ofs;
-	S->buf_ofs += MAC_BLOCK_SZ;
-	size_t data_pos = S->buf_ofs;
+	S->buf_ofs += seal_packet(S,
+		&dst[S->buf_ofs], type, out, out_sz, prepend, prepend_sz);
 
-/* MISSING OPTIMIZATION, extract n bytes of the cipherstream and apply copy
- * operation rather than in-place modification, align with MAC block size and
- * continuously update as we fetch as well */
+/* if we have set a function that will get the buffer immediately then we set
+ * the internal buffering state, this is a short-path that can be used
+ * immediately and then we reset it. */
+	if (S->opts->sink){
+		if (!S->opts->sink(dst, S->buf_ofs, S->opts->sink_tag)){
+			fail_state(S);
+		}
+		S->buf_ofs = 0;
+	}
 
-/* 8 byte sequence number */
-	pack_u64(S->current_seqnr++, &dst[S->buf_ofs]);
-	S->buf_ofs += 8;
+	check_rekey(S, out_sz + prepend_sz);
+}
 
-/* 1 byte command data */
-	dst[S->buf_ofs++] = type;
+/*
+ * Hold back a packet in the queue for [cl]. The packet buffer has the layout
+ * of the outer frame with the plaintext in place, sequence number, cipher and
+ * MAC are only applied when it is released as both are continuous and can't
+ * be reordered afterwards. That is done in place so the copy here is the only
+ * one the payload takes.
+ */
+static void outq_push(struct a12_state* S, int cl, uint8_t type,
+	const uint8_t* const out, size_t out_sz, uint8_t* prepend, size_t prepend_sz)
+{
+	size_t hdr = header_sizes[STATE_NOPACKET];
+	struct outq_packet* pkt =
+		DYNAMIC_MALLOC(sizeof(struct outq_packet) + hdr + prepend_sz + out_sz);
 
-/* any possible prepend-to-data block */
-	if (prepend_sz){
-		memcpy(&dst[S->buf_ofs], prepend, prepend_sz);
-		S->buf_ofs += prepend_sz;
+	if (!pkt){
+		a12int_trace(A12_TRACE_SYSTEM,
+			"kind=alloc:status=outq_fail:size=%zu", prepend_sz + out_sz);
+		fail_state(S);
+		return;
 	}
 
-/* and our data block */
-	memcpy(&dst[S->buf_ofs], out, out_sz);
-	S->buf_ofs += out_sz;
+	*pkt = (struct outq_packet){
+		.type = type,
+		.prepend_sz = prepend_sz,
+		.data_sz = out_sz
+	};
 
-	size_t used = S->buf_ofs - data_pos;
+	if (prepend_sz)
+		memcpy(&pkt->buf[hdr], prepend, prepend_sz);
+	memcpy(&pkt->buf[hdr + prepend_sz], out, out_sz);
+
+	if (S->outq[cl].last)
+		S->outq[cl].last->next = pkt;
+	else
+		S->outq[cl].first = pkt;
+	S->outq[cl].last = pkt;
+	S->outq[cl].bytes += prepend_sz + out_sz;
+
+	a12int_trace(A12_TRACE_ALLOC,
+		"kind=outq:class=%d:size=%zu:queued=%zu", cl, out_sz, S->outq[cl].bytes);
+}
+
+/* unlink the first packet of the highest priority class that has one */
+static struct outq_packet* outq_pop(struct a12_state* S)
+{
+	for (size_t i = OUTQ_AUDIO; i < OUTQ_COUNT; i++){
+		struct outq_packet* pkt = S->outq[i].first;
+		if (!pkt)
+			continue;
+
+		S->outq[i].first = pkt->next;
+		if (!S->outq[i].first)
+			S->outq[i].last = NULL;
+		S->outq[i].bytes -= pkt->prepend_sz + pkt->data_sz;
+		pkt->next = NULL;
+		return pkt;
+	}
+
+	return NULL;
+}
 
 /*
- * If we are the client and haven't sent the first authentication request
- * yet, setup the nonce part of the cipher to random and shorten the MAC.
- *
- * Thus the first packet has a half-length MAC and use the other half to
- * provide the nonce. This is mainly to reduce code complexity somewhat
- * and not have a different pre-header length for the first packet.
+ * Seal the next held back packet in its own buffer, this is used when the
+ * output buffer is empty so that the packet can be handed to the caller of
+ * a12_flush as is. It is kept in [outq_sent] until the next flush.
  */
-	size_t mac_sz = MAC_BLOCK_SZ;
-	if (S->authentic != AUTH_FULL_PK && !S->server && !S->cl_firstout){
-		mac_sz >>= 1;
-		arcan_random(&dst[mac_sz], mac_sz);
-		S->cl_firstout = true;
+static size_t outq_release(struct a12_state* S, uint8_t** buf)
+{
+	struct outq_packet* pkt = outq_pop(S);
+	if (!pkt)
+		return 0;
 
-		chacha_set_nonce(S->dec_state, &dst[mac_sz]);
-		chacha_set_nonce(S->enc_state, &dst[mac_sz]);
-		a12int_trace(A12_TRACE_CRYPTO, "kind=cipher:status=init_nonce");
+	size_t hdr = header_sizes[STATE_NOPACKET];
+	size_t sz = seal_packet(S, pkt->buf, pkt->type,
+		&pkt->buf[hdr + pkt->prepend_sz], pkt->data_sz,
+		&pkt->buf[hdr], pkt->prepend_sz);
 
-		trace_crypto_key(S->server, "nonce", &dst[mac_sz], mac_sz);
-/* don't forget to add the nonce to the first message MAC */
-		blake3_hasher_update(&S->out_mac, &dst[mac_sz], mac_sz);
-	}
+	S->outq_sent = pkt;
+	*buf = pkt->buf;
 
-/* apply stream-cipher to buffer contents - ETM */
-	chacha_apply(S->enc_state, &dst[data_pos], used);
+	check_rekey(S, pkt->data_sz + pkt->prepend_sz);
+	return sz;
+}
 
-/* update MAC with encrypted contents */
-	blake3_hasher_update(&S->out_mac, &dst[data_pos], used);
+/*
+ * Move held back packets to the output buffer in class priority order until
+ * the buffer has reached its cap, at least one packet is always moved so that
+ * a steady stream of control data can't starve the queues completely.
+ */
+static void outq_drain(struct a12_state* S)
+{
+	bool moved = false;
+	size_t hdr = header_sizes[STATE_NOPACKET];
 
-/* sample MAC and write to buffer pos, remember it for debugging - no need to
- * chain separately as 'finalize' is not really finalized */
-	blake3_hasher_finalize(&S->out_mac, &dst[mac_pos], mac_sz);
-	a12int_trace(A12_TRACE_CRYPTO, "kind=mac_enc:position=%zu", S->out_mac.counter);
-	trace_crypto_key(S->server, "mac_enc", &dst[mac_pos], mac_sz);
+	while ((!moved || S->buf_ofs < OUTQ_DIRECT_CAP) && S->state != STATE_BROKEN){
+		struct outq_packet* pkt = outq_pop(S);
+		if (!pkt)
+			break;
 
-	S->stats.b_out += out_sz + prepend_sz;
+		append_cipher(S, pkt->type, &pkt->buf[hdr + pkt->prepend_sz],
+			pkt->data_sz, &pkt->buf[hdr], pkt->prepend_sz);
+		DYNAMIC_FREE(pkt);
+		moved = true;
+	}
+}
 
-/* if we have set a function that will get the buffer immediately then we set
- * the internal buffering state, this is a short-path that can be used
- * immediately and then we reset it. */
-	if (S->opts->sink){
-		if (!S->opts->sink(dst, S->buf_ofs, S->opts->sink_tag)){
-			fail_state(S);
+static void outq_free(struct a12_state* S)
+{
+	for (size_t i = 0; i < OUTQ_COUNT; i++){
+		struct outq_packet* pkt = S->outq[i].first;
+		while (pkt){
+			struct outq_packet* next = pkt->next;
+			DYNAMIC_FREE(pkt);
+			pkt = next;
 		}
-		S->buf_ofs = 0;
+		S->outq[i].first = S->outq[i].last = NULL;
+		S->outq[i].bytes = 0;
 	}
 
-	if (S->keys.own_rekey &&
-		(!S->server || (S->server && S->keys.rekey_base_count))){
+	DYNAMIC_FREE(S->outq_sent);
+	S->outq_sent = NULL;
+}
 
-/* Is the byte counter covered? */
-		if (S->keys.rekey_base_count){
-			if (S->keys.rekey_count > out_sz + prepend_sz){
-				S->keys.rekey_count -= out_sz + prepend_sz;
-				return;
-			}
-		}
+/*
+ * Control and event packets are always ciphered into the output buffer right
+ * away, while audio and video are held back in their respective queues when
+ * the buffer has not been flushed fast enough - this lets input overtake bulk
+ * data and gives encoders a backlog measurement to react to.
+ */
+void a12int_append_out(struct a12_state* S, uint8_t type,
+	const uint8_t* const out, size_t out_sz, uint8_t* prepend, size_t prepend_sz)
+{
+	if (S->state == STATE_BROKEN)
+		return;
 
-		S->keys.rekey_count = S->keys.rekey_base_count;
-		a12int_issue_rekey(S);
+	int cl = S->out_class;
+	if (cl != OUTQ_CONTROL && !S->opts->sink &&
+		(S->outq[cl].first || S->buf_ofs >= OUTQ_DIRECT_CAP)){
+		outq_push(S, cl, type, out, out_sz, prepend, prepend_sz);
+		return;
 	}
+
+	append_cipher(S, type, out, out_sz, prepend, prepend_sz);
 }
 
 static void reset_state(struct a12_state* S)
@@ -763,6 +926,13 @@ a12_free(struct a12_state* S)
 		}
 	}
 
+	for (size_t i = 0; i < 256; i++){
+		a12int_decode_drop(S, i, false);
+		free(S->channels[i].apack.buf);
+		S->channels[i].apack.buf = NULL;
+		S->channels[i].apack.buf_sz = 0;
+	}
+
 	a12int_set_directory(S, NULL);
 
 	if (S->prepend_unpack){
@@ -772,6 +942,7 @@ a12_free(struct a12_state* S)
 	}
 
 	a12int_trace(A12_TRACE_ALLOC, "a12-state machine freed");
+	outq_free(S);
 	DYNAMIC_FREE(S->bufs[0]);
 	DYNAMIC_FREE(S->bufs[1]);
 	DYNAMIC_FREE(S->opts);
@@ -1461,6 +1632,14 @@ static void command_videoframe(struct a12_state* S)
 /* this includes TPACK */
 	else {
 		size_t ulim = vframe->w * vframe->h * sizeof(shmif_pixel);
+
+/* tiles can be scattered, so the limit is every tile + tile header */
+		if (vframe->postprocess == POSTPROCESS_VIDEO_TILEZSTD){
+			size_t cols = (vframe->sw + A12_TILE_SIZE - 1) / A12_TILE_SIZE;
+			size_t rows = (vframe->sh + A12_TILE_SIZE - 1) / A12_TILE_SIZE;
+			ulim = vframe->sw * vframe->sh * 3 + cols * rows * 4;
+		}
+
 		if (vframe->expanded_sz > ulim){
 			vframe->commit = 255;
 			a12int_trace(A12_TRACE_SYSTEM,
@@ -1485,7 +1664,7 @@ static void command_videoframe(struct a12_state* S)
 /* out_pos gets validated in the decode stage, so no OOB ->y ->x */
 		vframe->out_pos = vframe->y * cont->pitch + vframe->x;
 		vframe->inbuf_pos = 0;
-		vframe->inbuf = DYNAMIC_MALLOC(vframe->inbuf_sz);
+		vframe->inbuf = a12int_decode_inbuf(channel, vframe->inbuf_sz);
 		if (!vframe->inbuf){
 			a12int_trace(A12_TRACE_ALLOC,
 				"couldn't allocate intermediate buffer store");
@@ -1847,7 +2026,9 @@ static void process_hello_auth(struct a12_state* S)
 - [20]      Flags         : uint8
 - [21+ 32]  x25519 Pk     : blob,
 - [54]      Source/Sink
+- [71]      Features      : uint8 (bitmap)
 	 */
+	S->remote_features = S->decode[71];
 
 	if (S->decode[54]){
 		S->remote_mode = ROLE_PROBE;
@@ -2597,6 +2778,23 @@ static void process_video(struct a12_state* S)
 	reset_state(S);
 }
 
+uint8_t* a12int_apack_buffer(struct a12_state* S, uint8_t chid, size_t sz)
+{
+	struct a12_channel* ch = &S->channels[chid];
+	if (ch->apack.buf_sz >= sz)
+		return ch->apack.buf;
+
+	uint8_t* buf = realloc(ch->apack.buf, sz);
+	if (!buf){
+		a12int_trace(A12_TRACE_ALLOC, "failed to alloc %zu for audio packing", sz);
+		return NULL;
+	}
+
+	ch->apack.buf = buf;
+	ch->apack.buf_sz = sz;
+	return buf;
+}
+
 static void drain_audio(struct a12_channel* ch)
 {
 	struct arcan_shmif_cont* cont = ch->cont;
@@ -2681,14 +2879,43 @@ static void process_audio(struct a12_state* S)
  * both for rate and for drift/buffer */
 	size_t samples_in = S->decode_pos >> 1;
 	size_t pos = 0;
+	int16_t* dec = NULL;
+
+/* compressed blocks are expanded into the channel packing buffer first, the
+ * padding nibble of odd sized blocks gets cut by the remaining sample count */
+	if (caf->encoding == POSTPROCESS_AUDIO_ADPCM){
+		size_t cap = S->decode_pos * 2;
+		if (cap > caf->nsamples)
+			cap = caf->nsamples;
+
+		dec = (int16_t*) a12int_apack_buffer(S, S->in_channel, cap * sizeof(int16_t));
+		samples_in = dec ?
+			a12int_adpcm_decode(S->decode, S->decode_pos, caf->channels, dec, cap) : 0;
+	}
+	size_t consumed = samples_in;
+
+/* a block that doesn't decode is a protocol error, drop what is left of the
+ * frame rather than waiting for samples that will never arrive */
+	if (caf->encoding == POSTPROCESS_AUDIO_ADPCM && !samples_in && caf->nsamples){
+		a12int_trace(A12_TRACE_SYSTEM,
+			"kind=error:status=EINVAL:adpcm_block=%zu:dropped=%zu",
+			(size_t) S->decode_pos, (size_t) caf->nsamples);
+		consumed = caf->nsamples;
+	}
 
 /* assumed s16, stereo for now, if the sender didn't align properly, shame */
 	while (samples_in > 1){
 		int16_t l, r;
-		unpack_s16(&l, &S->decode[pos]);
-		pos += 2;
-		unpack_s16(&r, &S->decode[pos]);
-		pos += 2;
+		if (dec){
+			l = dec[pos++];
+			r = dec[pos++];
+		}
+		else {
+			unpack_s16(&l, &S->decode[pos]);
+			pos += 2;
+			unpack_s16(&r, &S->decode[pos]);
+			pos += 2;
+		}
 		cont->audp[cont->abufpos++] = SHMIF_AINT16(l);
 		cont->audp[cont->abufpos++] = SHMIF_AINT16(r);
 		samples_in -= 2;
@@ -2702,7 +2929,7 @@ static void process_audio(struct a12_state* S)
 
 /* now we can subtract the number of SAMPLES from the audio stream packet, when
  * that reaches zero we reset state, this incorrectly assumes 2 channels. */
-	caf->nsamples -= S->decode_pos >> 1;
+	caf->nsamples -= consumed > caf->nsamples ? caf->nsamples : consumed;
 
 /* drain if there is data left in the buffer, but no samples left */
 	if (!caf->nsamples && cont->abufused){
@@ -3180,17 +3407,35 @@ a12_flush(struct a12_state* S, uint8_t** buf, int allow_blob)
 	if (S->state == STATE_BROKEN || S->cookie != 0xfeedface)
 		return 0;
 
-/* Nothing in the outgoing buffer? then we can pull in whatever data transfer
- * is pending, if there are any queued. Repeat the append- until we have an
- * outgoing buffer of a certain size. */
-	if (S->buf_ofs == 0){
-		while (allow_blob > A12_FLUSH_NOBLOB &&
-			append_blob(S, allow_blob) && S->buf_ofs < BLOB_QUEUE_CAP){}
+/* the caller is done with the packet that was handed out last time */
+	if (S->outq_sent){
+		DYNAMIC_FREE(S->outq_sent);
+		S->outq_sent = NULL;
+	}
 
-		if (!S->buf_ofs)
-			return 0;
+/* nothing else waiting and no transfer that could use the space, then the
+ * next held back packet can be sealed and returned without a copy */
+	bool blobs = allow_blob > A12_FLUSH_NOBLOB && S->pending;
+	if (S->buf_ofs == 0 && !blobs){
+		size_t rv = outq_release(S, buf);
+		if (rv)
+			return rv;
 	}
 
+/* held back audio / video goes first, then we can pull in whatever data
+ * transfer is pending, if there are any queued. Repeat the append- until we
+ * have an outgoing buffer of a certain size, or only a budget on top of
+ * what audio / video already occupies. */
+	outq_drain(S);
+
+	if (blobs){
+		size_t cap = S->buf_ofs ? S->buf_ofs + OUTQ_BLOB_BUDGET : BLOB_QUEUE_CAP;
+		while (append_blob(S, allow_blob) && S->buf_ofs < cap){}
+	}
+
+	if (!S->buf_ofs)
+		return 0;
+
 	size_t rv = S->buf_ofs;
 	int old_ind = S->buf_ind;
 
@@ -3211,7 +3456,8 @@ a12_poll(struct a12_state* S)
 	if (!S || S->state == STATE_BROKEN || S->cookie != 0xfeedface)
 		return -1;
 
-	return S->buf_ofs || S->pending ? 1 : 0;
+	return S->buf_ofs || S->pending ||
+		S->outq[OUTQ_AUDIO].first || S->outq[OUTQ_VIDEO].first ? 1 : 0;
 }
 
 int
@@ -3253,14 +3499,20 @@ a12_channel_aframe(struct a12_state* S,
 	if (!S || S->cookie != 0xfeedface || S->state == STATE_BROKEN)
 		return;
 
-/* use a fix size now as the outb- writer lacks queueing and interleaving */
+/* chunk size only affects interleaving within the audio class now */
 	size_t chunk_sz = 16428;
 
 	a12int_trace(A12_TRACE_AUDIO,
 		"encode %zu samples @ %"PRIu32" Hz /%"PRIu8" ch",
 		n_samples, cfg.samplerate, cfg.channels
 	);
-	a12int_encode_araw(S, S->out_channel, buf, n_samples/2, cfg, opts, chunk_sz);
+	S->out_class = OUTQ_AUDIO;
+	if (opts.method == AFRAME_METHOD_ADPCM &&
+		(S->remote_features & HELLO_FEATURE_AUDIO_ADPCM))
+		a12int_encode_aadpcm(S, S->out_channel, buf, n_samples/2, cfg, opts, chunk_sz);
+	else
+		a12int_encode_araw(S, S->out_channel, buf, n_samples/2, cfg, opts, chunk_sz);
+	S->out_class = OUTQ_CONTROL;
 }
 
 /*
@@ -3274,7 +3526,7 @@ a12_channel_vframe(struct a12_state* S,
 	if (!S || S->cookie != 0xfeedface || S->state == STATE_BROKEN)
 		return;
 
-/* use a fix size now as the outb- writer lacks queueing and interleaving */
+/* chunk size only affects interleaving within the video class now */
 	size_t chunk_sz = 32768;
 
 /* avoid dumb updates */
@@ -3303,9 +3555,53 @@ a12_channel_vframe(struct a12_state* S,
 		h = vb->h;
 	}
 
-/* option: quadtree delta- buffer and only distribute the updated
- * cells? should cut down on memory bandwidth on decode side and
- * on rle/compressing */
+/* VFRAME_METHOD_TILE_ZSTD splits the frame into fixed size tiles and only
+ * distributes the updated ones, the subregion limits which tiles to check */
+
+/* if the socket is so far behind that the video queue has built up, skip the
+ * frame and remember its region so the next one that gets through covers it,
+ * pre-compressed passthrough can't be merged like that so it always goes */
+	struct a12_channel* ch = &S->channels[S->out_channel];
+	if (!vb->flags.compressed && S->outq[OUTQ_VIDEO].bytes > OUTQ_VIDEO_DROP){
+		if (ch->vdrop.pending){
+			ch->vdrop.x1 = x < ch->vdrop.x1 ? x : ch->vdrop.x1;
+			ch->vdrop.y1 = y < ch->vdrop.y1 ? y : ch->vdrop.y1;
+			ch->vdrop.x2 = x + w > ch->vdrop.x2 ? x + w : ch->vdrop.x2;
+			ch->vdrop.y2 = y + h > ch->vdrop.y2 ? y + h : ch->vdrop.y2;
+		}
+		else {
+			ch->vdrop.pending = true;
+			ch->vdrop.x1 = x;
+			ch->vdrop.y1 = y;
+			ch->vdrop.x2 = x + w;
+			ch->vdrop.y2 = y + h;
+		}
+
+		S->stats.vframe_dropped++;
+		a12int_trace(A12_TRACE_VIDEO,
+			"kind=drop:queued=%zu:dropped=%zu",
+			S->outq[OUTQ_VIDEO].bytes, S->stats.vframe_dropped);
+		return;
+	}
+
+/* merge what was dropped before, a resize since then means a full frame */
+	if (ch->vdrop.pending){
+		if (ch->vdrop.x2 > vb->w || ch->vdrop.y2 > vb->h){
+			x = 0;
+			y = 0;
+			w = vb->w;
+			h = vb->h;
+		}
+		else {
+			size_t x2 = x + w > ch->vdrop.x2 ? x + w : ch->vdrop.x2;
+			size_t y2 = y + h > ch->vdrop.y2 ? y + h : ch->vdrop.y2;
+			x = x < ch->vdrop.x1 ? x : ch->vdrop.x1;
+			y = y < ch->vdrop.y1 ? y : ch->vdrop.y1;
+			w = x2 - x;
+			h = y2 - y;
+		}
+		ch->vdrop.pending = false;
+	}
 
 /* dealing with each flag:
  * origo_ll - do the coversion in our own encode- stage
@@ -3327,6 +3623,8 @@ a12_channel_vframe(struct a12_state* S,
 
 /* we have a pre-compressed passthrough - send it with the FOURCC stored
  * in place of expanded length and just send the buffer as is */
+	S->out_class = OUTQ_VIDEO;
+
 	if (vb->flags.compressed)
 		a12int_encode_passthrough(argstr);
 	else
@@ -3357,12 +3655,18 @@ a12_channel_vframe(struct a12_state* S,
 	case VFRAME_METHOD_TPACK_ZSTD:
 		a12int_encode_ztz(argstr);
 	break;
+	case VFRAME_METHOD_TILE_ZSTD:
+		a12int_encode_tiled(argstr);
+	break;
 	default:
 		a12int_trace(A12_TRACE_SYSTEM, "unknown format: %d\n", opts.method);
+		S->out_class = OUTQ_CONTROL;
 		return;
 	break;
 	}
 
+	S->out_class = OUTQ_CONTROL;
+
 	size_t then = arcan_timemillis();
 	if (then > now){
 		S->stats.ms_vframe = then - now;
@@ -3496,7 +3800,11 @@ a12_set_bhandler(struct a12_state* S,
 
 struct a12_iostat a12_state_iostat(struct a12_state* S)
 {
-/* just an accessor, values are updated continously */
+/* mostly an accessor, values are updated continously except for the queue
+ * depths that are sampled here */
+	S->stats.out_buffer = S->buf_ofs;
+	S->stats.out_queue_audio = S->outq[OUTQ_AUDIO].bytes;
+	S->stats.out_queue_video = S->outq[OUTQ_VIDEO].bytes;
 	return S->stats;
 }
 
@@ -133,6 +133,13 @@ struct a12_context_options {
  * marks the state machine as broken. */
 	bool (*sink)(uint8_t* buf, size_t buf_sz, void* tag);
 	void* sink_tag;
+
+/* if set, video frames large enough to benefit will be compressed using this
+ * many zstd worker threads. The call still blocks until the frame has been
+ * compressed and queued, but finishes that much sooner so that event and
+ * audio processing for the connection isn't stalled. 0 (default) compresses
+ * on the calling thread. */
+	size_t compression_threads;
 };
 
 /*
@@ -454,7 +461,8 @@ enum a12_vframe_method {
 	VFRAME_METHOD_H264 = 5,
 	VFRAME_METHOD_TPACK_ZSTD = 7,
 	VFRAME_METHOD_ZSTD = 8,
-	VFRAME_METHOD_DZSTD = 9
+	VFRAME_METHOD_DZSTD = 9,
+	VFRAME_METHOD_TILE_ZSTD = 10 /* DZSTD, but only sends changed tiles */
 };
 
 enum a12_stream_types {
@@ -493,6 +501,10 @@ struct a12_vframe_opts {
 
 enum a12_aframe_method {
 	AFRAME_METHOD_RAW = 0,
+
+/* 4:1 lossy built-in codec (IMA-ADPCM), falls back to RAW if the other side
+ * did not announce support for it in the hello */
+	AFRAME_METHOD_ADPCM = 1
 };
 
 struct a12_aframe_opts {
@@ -665,6 +677,10 @@ struct a12_iostat {
 	size_t ms_vframe;           /* for last encoded video frame */
 	float ms_vframe_px;
 	size_t packets_pending;     /* delta between seqnr and last-seen seqnr */
+	size_t out_buffer;          /* bytes ciphered and waiting for a12_flush */
+	size_t out_queue_audio;     /* bytes of audio held back by backlog */
+	size_t out_queue_video;     /* bytes of video held back by backlog */
+	size_t vframe_dropped;      /* vframes skipped due to video backlog */
 };
 
 /* get / set a string representation for logging and similar operations
@@ -0,0 +1,161 @@
+/*
+ * Copyright: Björn Ståhl
+ * Description: A12 protocol state machine, IMA-ADPCM audio block codec
+ * License: 3-Clause BSD, see COPYING file in arcan source repository.
+ * Reference: https://arcan-fe.com
+ */
+#include <arcan_shmif.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "a12_adpcm.h"
+#include "pack.h"
+
+static const int16_t step_table[89] = {
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+	253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+	1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+	3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+	11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+	32767
+};
+
+static const int8_t index_table[16] = {
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+struct adpcm_state {
+	int pred;
+	int index;
+};
+
+static inline void step_state(struct adpcm_state* st, uint8_t code)
+{
+	int step = step_table[st->index];
+	int delta = step >> 3;
+
+	if (code & 4)
+		delta += step;
+	if (code & 2)
+		delta += step >> 1;
+	if (code & 1)
+		delta += step >> 2;
+
+	st->pred += (code & 8) ? -delta : delta;
+	if (st->pred > 32767)
+		st->pred = 32767;
+	else if (st->pred < -32768)
+		st->pred = -32768;
+
+	st->index += index_table[code];
+	if (st->index < 0)
+		st->index = 0;
+	else if (st->index > 88)
+		st->index = 88;
+}
+
+static inline uint8_t encode_sample(struct adpcm_state* st, int sample)
+{
+	int step = step_table[st->index];
+	int diff = sample - st->pred;
+	uint8_t code = 0;
+
+	if (diff < 0){
+		code = 8;
+		diff = -diff;
+	}
+
+	if (diff >= step){
+		code |= 4;
+		diff -= step;
+	}
+	step >>= 1;
+	if (diff >= step){
+		code |= 2;
+		diff -= step;
+	}
+	step >>= 1;
+	if (diff >= step)
+		code |= 1;
+
+/* decoder and encoder must agree on the reconstructed value */
+	step_state(st, code);
+	return code;
+}
+
+size_t a12int_adpcm_block_size(size_t frames, uint8_t channels)
+{
+	return channels * 4 + (frames * channels + 1) / 2;
+}
+
+size_t a12int_adpcm_encode(const shmif_asample* in,
+	size_t frames, uint8_t channels, uint8_t* index, uint8_t* out)
+{
+	struct adpcm_state st[A12_ADPCM_MAX_CHANNELS];
+	if (!channels || channels > A12_ADPCM_MAX_CHANNELS || !frames)
+		return 0;
+
+/* the first sample of each channel is the predictor so there is no error
+ * carried over from the previous block, only the step index */
+	uint8_t* pos = out;
+	for (size_t i = 0; i < channels; i++){
+		st[i].pred = (int16_t) in[i];
+		st[i].index = index[i] > 88 ? 88 : index[i];
+		pack_s16(st[i].pred, pos);
+		pos[2] = st[i].index;
+		pos[3] = 0;
+		pos += 4;
+	}
+
+	size_t n = frames * channels;
+	for (size_t i = 0; i < n; i += 2){
+		uint8_t lo = encode_sample(&st[i % channels], (int16_t) in[i]);
+		uint8_t hi = 0;
+		if (i + 1 < n)
+			hi = encode_sample(&st[(i + 1) % channels], (int16_t) in[i + 1]);
+		*pos++ = lo | (hi << 4);
+	}
+
+	for (size_t i = 0; i < channels; i++)
+		index[i] = st[i].index;
+
+	return pos - out;
+}
+
+size_t a12int_adpcm_decode(const uint8_t* in,
+	size_t in_sz, uint8_t channels, int16_t* out, size_t out_cap)
+{
+	struct adpcm_state st[A12_ADPCM_MAX_CHANNELS];
+	size_t hdr_sz = channels * 4;
+
+	if (!channels || channels > A12_ADPCM_MAX_CHANNELS || in_sz <= hdr_sz)
+		return 0;
+
+	for (size_t i = 0; i < channels; i++){
+		int16_t pred;
+		unpack_s16(&pred, (uint8_t*) &in[i * 4]);
+		st[i].pred = pred;
+		st[i].index = in[i * 4 + 2];
+		if (st[i].index > 88)
+			return 0;
+	}
+
+/* an odd sample count leaves a padding nibble at the end, the caller bounds
+ * that away with the sample count from the stream header */
+	size_t n = (in_sz - hdr_sz) * 2;
+	n -= n % channels;
+	if (n > out_cap)
+		n = out_cap - out_cap % channels;
+
+	const uint8_t* pos = &in[hdr_sz];
+	for (size_t i = 0; i < n; i++){
+		uint8_t code = (i & 1) ? (pos[i >> 1] >> 4) : (pos[i >> 1] & 0x0f);
+		struct adpcm_state* cs = &st[i % channels];
+		step_state(cs, code);
+		out[i] = cs->pred;
+	}
+
+	return n;
+}
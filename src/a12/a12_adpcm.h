@@ -0,0 +1,37 @@
+#ifndef HAVE_A12_ADPCM
+#define HAVE_A12_ADPCM
+
+/*
+ * IMA-ADPCM block codec used for AFRAME_METHOD_ADPCM, 4 bits per sample with
+ * every block decodable on its own:
+ *
+ *  per channel: [s16 predictor][u8 step index][u8 reserved]
+ *  then one nibble per sample in the same interleaving as the input, lower
+ *  nibble first.
+ *
+ * The step index is carried between blocks by the encoder so that the
+ * quantizer doesn't have to adapt from scratch every block.
+ */
+
+#define A12_ADPCM_MAX_CHANNELS 8
+
+/* bytes needed to encode [frames] samples of [channels] each */
+size_t a12int_adpcm_block_size(size_t frames, uint8_t channels);
+
+/*
+ * encode [frames] interleaved frames from [in] into [out], [index] is the
+ * per-channel step index that is updated on return, returns the number of
+ * bytes written (a12int_adpcm_block_size)
+ */
+size_t a12int_adpcm_encode(const shmif_asample* in,
+	size_t frames, uint8_t channels, uint8_t* index, uint8_t* out);
+
+/*
+ * decode the [in_sz] bytes block in [in] into at most [out_cap] interleaved
+ * samples in [out], returns the number of samples (not frames) written or 0
+ * if the block is malformed
+ */
+size_t a12int_adpcm_decode(const uint8_t* in,
+	size_t in_sz, uint8_t channels, int16_t* out, size_t out_cap);
+
+#endif
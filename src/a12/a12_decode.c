@@ -47,7 +47,8 @@ bool a12int_buffer_format(int method)
 		method == POSTPROCESS_VIDEO_H264 ||
 		method == POSTPROCESS_VIDEO_TZSTD ||
 		method == POSTPROCESS_VIDEO_ZSTD ||
-		method == POSTPROCESS_VIDEO_DZSTD;
+		method == POSTPROCESS_VIDEO_DZSTD ||
+		method == POSTPROCESS_VIDEO_TILEZSTD;
 }
 
 static int video_miniz(const void* buf, int len, void* user)
@@ -148,6 +149,106 @@ static int video_miniz(const void* buf, int len, void* user)
 	return 1;
 }
 
+/*
+ * Patch each [col, row, tile ^ ref] record into the current contents of the
+ * shmif buffer, which acts as the reference frame just like for DZSTD.
+ */
+static void video_tiles(struct a12_state* S, const uint8_t* buf, size_t len)
+{
+	struct arcan_shmif_cont* cont = S->channels[S->in_channel].cont;
+	if (!cont)
+		return;
+
+	size_t pos = 0;
+	while (len - pos >= 4){
+		uint16_t col, row;
+		unpack_u16(&col, (uint8_t*) &buf[pos]);
+		unpack_u16(&row, (uint8_t*) &buf[pos+2]);
+		pos += 4;
+
+		size_t tx = (size_t) col * A12_TILE_SIZE;
+		size_t ty = (size_t) row * A12_TILE_SIZE;
+		if (tx >= cont->w || ty >= cont->h){
+			a12int_trace(A12_TRACE_SYSTEM,
+				"kind=decode_error:col=%zu:row=%zu:message=tile out of bounds",
+				(size_t) col, (size_t) row
+			);
+			return;
+		}
+
+		size_t tw = cont->w - tx < A12_TILE_SIZE ? cont->w - tx : A12_TILE_SIZE;
+		size_t th = cont->h - ty < A12_TILE_SIZE ? cont->h - ty : A12_TILE_SIZE;
+		if (len - pos < tw * th * 3){
+			a12int_trace(A12_TRACE_SYSTEM,
+				"kind=decode_error:message=truncated tile");
+			return;
+		}
+
+		for (size_t y = 0; y < th; y++){
+			shmif_pixel* dst = &cont->vidp[(ty + y) * cont->pitch + tx];
+			for (size_t x = 0; x < tw; x++, pos += 3){
+				uint8_t r, g, b, a;
+				SHMIF_RGBA_DECOMP(dst[x], &r, &g, &b, &a);
+				dst[x] = SHMIF_RGBA(
+					buf[pos+0] ^ r, buf[pos+1] ^ g, buf[pos+2] ^ b, 0xff);
+			}
+		}
+	}
+}
+
+/*
+ * Formats that don't depend on the previous contents of the destination can
+ * be decompressed straight into it, saving the intermediate buffer and copy.
+ * TPACK is a plain byte copy, while ZSTD I-frames covering whole rows get the
+ * packed RGB placed at the end of the region and expanded in place, front to
+ * back, as the write position never passes the read position. Returns false
+ * if the frame needs to go through the intermediate buffer.
+ */
+static bool decode_direct(struct a12_channel* ch,
+	struct video_frame* cvf, struct arcan_shmif_cont* cont, size_t content_sz)
+{
+	if (!cont || !cont->vidp || cvf->carry)
+		return false;
+
+	uint8_t* dst;
+	size_t buf_sz = (size_t) cont->pitch * cont->h * sizeof(shmif_pixel);
+
+	if (cvf->postprocess == POSTPROCESS_VIDEO_TZSTD){
+		if (cvf->out_pos + content_sz > buf_sz)
+			return false;
+		dst = &cont->vidb[cvf->out_pos];
+	}
+	else if (cvf->postprocess == POSTPROCESS_VIDEO_ZSTD){
+		size_t npx = (size_t) cvf->w * cvf->h;
+		if (cvf->x || cvf->w != cont->pitch || content_sz != npx * 3 ||
+			(cvf->out_pos + npx) * sizeof(shmif_pixel) > buf_sz)
+			return false;
+		dst = (uint8_t*) &cont->vidp[cvf->out_pos + npx] - content_sz;
+	}
+	else
+		return false;
+
+	size_t decode = ZSTD_decompressDCtx(
+		ch->varena.zstd, dst, content_sz, cvf->inbuf, cvf->inbuf_pos);
+	a12int_trace(A12_TRACE_VIDEO, "kind=zstd_state:direct:%zu", decode);
+
+	if (ZSTD_isError(decode) || decode != content_sz){
+		a12int_trace(A12_TRACE_SYSTEM, "kind=decode_error:message=%s",
+			ZSTD_isError(decode) ? ZSTD_getErrorName(decode) : "short frame");
+		return true;
+	}
+
+	if (cvf->postprocess == POSTPROCESS_VIDEO_ZSTD){
+		shmif_pixel* out = &cont->vidp[cvf->out_pos];
+		size_t npx = content_sz / 3;
+		for (size_t i = 0; i < npx; i++, dst += 3)
+			out[i] = SHMIF_RGBA(dst[0], dst[1], dst[2], 0xff);
+	}
+
+	cvf->expanded_sz -= content_sz;
+	return true;
+}
+
 #ifdef WANT_H264_DEC
 
 void ffmpeg_decode_pkt(
@@ -257,13 +358,41 @@ static bool ffmpeg_alloc(struct a12_channel* ch, int method)
 }
 #endif
 
+static uint8_t* varena_grow(uint8_t** buf, size_t* buf_sz, size_t sz)
+{
+	if (*buf_sz >= sz)
+		return *buf;
+
+/* no need to preserve contents, so avoid the realloc copy */
+	free(*buf);
+	*buf = malloc(sz);
+	*buf_sz = *buf ? sz : 0;
+
+	if (!*buf)
+		a12int_trace(A12_TRACE_ALLOC, "kind=error:varena_alloc=%zu", sz);
+
+	return *buf;
+}
+
+uint8_t* a12int_decode_inbuf(struct a12_channel* ch, size_t sz)
+{
+	return varena_grow(&ch->varena.in, &ch->varena.in_sz, sz);
+}
+
 void a12int_decode_drop(struct a12_state* S, int chid, bool failed)
 {
-	if (S->channels[chid].unpack_state.vframe.zstd){
-		ZSTD_freeDCtx(S->channels[chid].unpack_state.vframe.zstd);
-		S->channels[chid].zstd = NULL;
+	struct a12_channel* ch = &S->channels[chid];
+	if (ch->varena.zstd){
+		ZSTD_freeDCtx(ch->varena.zstd);
+		ch->varena.zstd = NULL;
 	}
 
+	free(ch->varena.in);
+	free(ch->varena.out);
+	ch->varena.in = ch->varena.out = NULL;
+	ch->varena.in_sz = ch->varena.out_sz = 0;
+	ch->unpack_state.vframe.inbuf = NULL;
+
 #if defined(WANT_H264_ENC) || defined(WANT_H264_DEC)
 	if (!S->channels[chid].videnc.encdec)
 		return;
@@ -300,27 +429,33 @@ void a12int_decode_vbuffer(struct a12_state* S,
 	a12int_trace(A12_TRACE_VIDEO, "decode vbuffer, method: %d", cvf->postprocess);
 	if ( cvf->postprocess == POSTPROCESS_VIDEO_DZSTD
 		|| cvf->postprocess == POSTPROCESS_VIDEO_ZSTD
-		|| cvf->postprocess == POSTPROCESS_VIDEO_TZSTD)
+		|| cvf->postprocess == POSTPROCESS_VIDEO_TZSTD
+		|| cvf->postprocess == POSTPROCESS_VIDEO_TILEZSTD)
 	{
 		uint64_t content_sz = ZSTD_getFrameContentSize(cvf->inbuf, cvf->inbuf_pos);
 
 /* repeat and compare, don't le/gt */
 		if (content_sz == cvf->expanded_sz){
-			if (!ch->unpack_state.vframe.zstd &&
-				!(ch->unpack_state.vframe.zstd = ZSTD_createDCtx())){
+			if (!ch->varena.zstd && !(ch->varena.zstd = ZSTD_createDCtx())){
 				a12int_trace(A12_TRACE_SYSTEM,
 					"kind=alloc_error:zstd_context_alloc");
 			}
-/* actually decompress */
-			else {
-				void* buffer = malloc(content_sz);
+/* actually decompress, straight to the destination if possible */
+			else if (!decode_direct(ch, cvf, cont, content_sz)){
+				uint8_t* buffer =
+					varena_grow(&ch->varena.out, &ch->varena.out_sz, content_sz);
 				if (buffer){
-					uint64_t decode =
-						ZSTD_decompressDCtx(ch->unpack_state.vframe.zstd,
+					size_t decode =
+						ZSTD_decompressDCtx(ch->varena.zstd,
 							buffer, content_sz, cvf->inbuf, cvf->inbuf_pos);
-					a12int_trace(A12_TRACE_VIDEO, "kind=zstd_state:%"PRIu64, decode);
-					video_miniz(buffer, content_sz, S);
-					free(buffer);
+					a12int_trace(A12_TRACE_VIDEO, "kind=zstd_state:%zu", decode);
+					if (ZSTD_isError(decode))
+						a12int_trace(A12_TRACE_SYSTEM,
+							"kind=decode_error:message=%s", ZSTD_getErrorName(decode));
+					else if (cvf->postprocess == POSTPROCESS_VIDEO_TILEZSTD)
+						video_tiles(S, buffer, content_sz);
+					else
+						video_miniz(buffer, content_sz, S);
 				}
 			}
 		}
@@ -331,7 +466,7 @@ void a12int_decode_vbuffer(struct a12_state* S,
 			);
 		}
 
-		free(cvf->inbuf);
+/* the buffer itself belongs to the channel varena */
 		cvf->inbuf = NULL;
 		cvf->carry = 0;
 
@@ -387,7 +522,6 @@ void a12int_decode_vbuffer(struct a12_state* S,
 		}
 
 out_h264:
-		free(cvf->inbuf);
 		cvf->inbuf = NULL;
 		cvf->carry = 0;
 		return;
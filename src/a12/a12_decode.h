@@ -9,6 +9,9 @@ bool a12int_buffer_format(int method);
 
 bool a12int_vframe_setup(struct a12_channel* ch, struct video_frame* dst, int method);
 
+/* Get the channel input buffer for a compressed frame of [sz] bytes */
+uint8_t* a12int_decode_inbuf(struct a12_channel* ch, size_t sz);
+
 /* Release any encoder contexts and intermediate buffers tied to the state/channel */
 void a12int_decode_drop(struct a12_state* S, int chid, bool failed);
 
@@ -14,10 +14,13 @@
 #include "a12.h"
 #include "a12_int.h"
 #include "a12_encode.h"
+#include "a12_pxpack.h"
+#include "a12_adpcm.h"
 #include "../shmif/tui/raster/raster_const.h"
 
 #define ZSTD_H_ZSTD_STATIC_LINKING_ONLY
 #include "zstd.h"
+#include "xxhash.h"
 
 /*
  * create the control packet
@@ -85,6 +88,23 @@ static void chunk_pack(struct a12_state* S, int type,
 		a12int_append_out(S, type, &buf[n_chunks * chunk_sz], left, outb, sizeof(outb));
 }
 
+static void aframehdr_build(struct a12_state* S,
+	uint8_t buf[CONTROL_PACKET_SIZE], uint8_t chid,
+	struct a12_aframe_cfg cfg, uint8_t encoding, uint16_t n_samples)
+{
+	memset(buf, '\0', CONTROL_PACKET_SIZE);
+	pack_u64(S->last_seen_seqnr, &buf[0]);
+	arcan_random(&buf[8], 8);
+
+	buf[16] = chid;
+	buf[17] = COMMAND_AUDIOFRAME;
+	pack_u32(0, &buf[18]); /* stream-id */
+	buf[22] = cfg.channels; /* channels */
+	buf[23] = encoding;
+	pack_u16(n_samples, &buf[24]);
+	pack_u32(cfg.samplerate, &buf[26]);
+}
+
 void a12int_encode_araw(struct a12_state* S,
 	uint8_t chid,
 	shmif_asample* buf,
@@ -92,35 +112,94 @@ void a12int_encode_araw(struct a12_state* S,
 	struct a12_aframe_cfg cfg,
 	struct a12_aframe_opts opts, size_t chunk_sz)
 {
-/* repack the audio into a temporary buffer for format reasons */
-	size_t hdr_sz = a12int_header_size(STATE_AUDIO_PACKET);
-	size_t buf_sz = hdr_sz + n_samples * sizeof(uint16_t) * cfg.channels;
-	uint8_t* outb = malloc(hdr_sz + buf_sz);;
-	if (!outb){
-		a12int_trace(A12_TRACE_ALLOC,
-			"failed to alloc %zu for s16aud", buf_sz);
+/* repack the audio into the channel packing buffer for format reasons */
+	uint8_t* outb = a12int_apack_buffer(S, chid, n_samples * sizeof(uint16_t));
+	if (!outb)
 		return;
-	}
 
-/* audio control message header */
-	outb[16] = chid;
-	outb[17] = COMMAND_AUDIOFRAME;
-	pack_u32(0, &outb[18]); /* stream-id */
-	outb[22] = cfg.channels; /* channels */
-	outb[23] = 0; /* encoding, u16 */
-	pack_u16(n_samples, &outb[24]);
+	uint8_t hdr[CONTROL_PACKET_SIZE];
+	aframehdr_build(S, hdr, chid, cfg, POSTPROCESS_AUDIO_S16, n_samples);
 
 /* repack into the right format (note, need _Generic on asample) */
-	size_t pos = hdr_sz;
+	size_t pos = 0;
 	for (size_t i = 0; i < n_samples; i++, pos += 2){
 		pack_s16(buf[i], &outb[pos]);
 	}
 
 /* then split it up (though likely we get fed much smaller chunks) */
-	a12int_append_out(S,
-		STATE_CONTROL_PACKET, outb, CONTROL_PACKET_SIZE, NULL, 0);
-	chunk_pack(S, STATE_AUDIO_PACKET, chid, &outb[hdr_sz], pos - hdr_sz, chunk_sz);
-	free(outb);
+	a12int_append_out(S, STATE_CONTROL_PACKET, hdr, CONTROL_PACKET_SIZE, NULL, 0);
+	chunk_pack(S, STATE_AUDIO_PACKET, chid, outb, pos, chunk_sz);
+}
+
+void a12int_encode_aadpcm(struct a12_state* S,
+	uint8_t chid,
+	shmif_asample* buf,
+	uint16_t n_samples,
+	struct a12_aframe_cfg cfg,
+	struct a12_aframe_opts opts, size_t chunk_sz)
+{
+	if (!cfg.channels || cfg.channels > A12_ADPCM_MAX_CHANNELS){
+		a12int_encode_araw(S, chid, buf, n_samples, cfg, opts, chunk_sz);
+		return;
+	}
+
+/* every audio packet carries one self-contained block so the decoder never
+ * has to deal with a block split across packets, size the blocks so that
+ * they fit the chunk size */
+	size_t hdr_sz = a12int_header_size(STATE_AUDIO_PACKET);
+	size_t frames = n_samples / cfg.channels;
+	size_t block_frames = ((chunk_sz - hdr_sz - cfg.channels * 4) * 2) / cfg.channels;
+	if (!frames || !block_frames)
+		return;
+
+	uint8_t* outb = a12int_apack_buffer(S, chid,
+		a12int_adpcm_block_size(block_frames, cfg.channels));
+	if (!outb)
+		return;
+
+	uint8_t hdr[CONTROL_PACKET_SIZE];
+	aframehdr_build(S, hdr, chid, cfg,
+		POSTPROCESS_AUDIO_ADPCM, frames * cfg.channels);
+	a12int_append_out(S, STATE_CONTROL_PACKET, hdr, CONTROL_PACKET_SIZE, NULL, 0);
+
+	uint8_t pkt[hdr_sz];
+	pkt[0] = chid; /* [0] : channel id */
+	pack_u32(0xbacabaca, &pkt[1]); /* [1..4] : stream */
+
+	for (size_t i = 0; i < frames; i += block_frames){
+		size_t nf = frames - i > block_frames ? block_frames : frames - i;
+		size_t nb = a12int_adpcm_encode(&buf[i * cfg.channels],
+			nf, cfg.channels, S->channels[chid].apack.index, outb);
+
+		pack_u16(nb, &pkt[5]); /* [5..6] : length */
+		a12int_append_out(S, STATE_AUDIO_PACKET, outb, nb, pkt, hdr_sz);
+	}
+}
+
+/*
+ * Pack [n] pixels from the [w] wide region in [vb] using one of the pxpack
+ * kernels. Packets don't line up with rows so [pos] and [row_len] carry the
+ * read position between calls.
+ */
+static void pack_span(
+	void (*kernel)(const shmif_pixel*, uint8_t*, size_t),
+	struct shmifsrv_vbuffer* vb, size_t w,
+	size_t* pos, size_t* row_len, uint8_t* out, size_t n, size_t px_sz)
+{
+	while (n){
+		size_t step = n < *row_len ? n : *row_len;
+		kernel(&vb->buffer[*pos], out, step);
+
+		out += step * px_sz;
+		*pos += step;
+		*row_len -= step;
+		n -= step;
+
+		if (*row_len == 0){
+			*pos += vb->pitch - w;
+			*row_len = w;
+		}
+	}
 }
 
 /*
@@ -136,7 +215,6 @@ void a12int_encode_rgb565(PACK_ARGS)
 	size_t bpb = ppb * px_sz;
 	size_t blocks = w * h / ppb;
 
-	shmif_pixel* inbuf = vb->buffer;
 	size_t pos = y * vb->pitch + x;
 
 /* get the packing buffer, cancel if oom */
@@ -163,22 +241,8 @@ void a12int_encode_rgb565(PACK_ARGS)
 /* sweep the incoming frame, and pack maximum block size */
 	size_t row_len = w;
 	for (size_t i = 0; i < blocks; i++){
-		for (size_t j = 0; j < bpb; j += px_sz){
-			uint8_t r, g, b, ign;
-			uint16_t px;
-			SHMIF_RGBA_DECOMP(inbuf[pos++], &r, &g, &b, &ign);
-			px =
-				(((b >> 3) & 0x1f) << 0) |
-				(((g >> 2) & 0x3f) << 5) |
-				(((r >> 3) & 0x1f) << 11)
-			;
-			pack_u16(px, &outb[hdr_sz+j]);
-			row_len--;
-			if (row_len == 0){
-				pos += vb->pitch - w;
-				row_len = w;
-			}
-		}
+		pack_span(a12int_pxpack_rgb565,
+			vb, w, &pos, &row_len, &outb[hdr_sz], ppb, px_sz);
 		a12int_append_out(S, STATE_VIDEO_PACKET, outb, hdr_sz + bpb, NULL, 0);
 	}
 
@@ -187,22 +251,8 @@ void a12int_encode_rgb565(PACK_ARGS)
 	if (left){
 		pack_u16(left, &outb[5]);
 		a12int_trace(A12_TRACE_VDETAIL, "small block of %zu bytes", left);
-		for (size_t i = 0; i < left; i+= px_sz){
-			uint8_t r, g, b, ign;
-			uint16_t px;
-			SHMIF_RGBA_DECOMP(inbuf[pos++], &r, &g, &b, &ign);
-			px =
-				(((b >> 3) & 0x1f) << 0) |
-				(((g >> 2) & 0x3f) << 5) |
-				(((r >> 3) & 0x1f) << 11)
-			;
-			pack_u16(px, &outb[hdr_sz+i]);
-			row_len--;
-			if (row_len == 0){
-				pos += vb->pitch - w;
-				row_len = w;
-			}
-		}
+		pack_span(a12int_pxpack_rgb565,
+			vb, w, &pos, &row_len, &outb[hdr_sz], left / px_sz, px_sz);
 		a12int_append_out(S, STATE_VIDEO_PACKET, outb, left+hdr_sz, NULL, 0);
 	}
 
@@ -234,7 +284,6 @@ void a12int_encode_rgba(PACK_ARGS)
 	size_t bpb = ppb * px_sz;
 	size_t blocks = w * h / ppb;
 
-	shmif_pixel* inbuf = vb->buffer;
 	size_t pos = y * vb->pitch + x;
 
 /* get the packing buffer, cancel if oom */
@@ -259,15 +308,8 @@ void a12int_encode_rgba(PACK_ARGS)
 /* sweep the incoming frame, and pack maximum block size */
 	size_t row_len = w;
 	for (size_t i = 0; i < blocks; i++){
-		for (size_t j = 0; j < bpb; j += px_sz){
-			uint8_t* dst = &outb[hdr_sz+j];
-			SHMIF_RGBA_DECOMP(inbuf[pos++], &dst[0], &dst[1], &dst[2], &dst[3]);
-			row_len--;
-			if (row_len == 0){
-				pos += vb->pitch - w;
-				row_len = w;
-			}
-		}
+		pack_span(a12int_pxpack_rgba,
+			vb, w, &pos, &row_len, &outb[hdr_sz], ppb, px_sz);
 
 /* dispatch to out-queue(s) */
 		a12int_append_out(S, STATE_VIDEO_PACKET, outb, hdr_sz + bpb, NULL, 0);
@@ -279,15 +321,8 @@ void a12int_encode_rgba(PACK_ARGS)
 		pack_u16(left, &outb[5]);
 		a12int_trace(A12_TRACE_VDETAIL,
 			"kind=status:message=padblock:size=%zu", left);
-		for (size_t i = 0; i < left; i+= px_sz){
-			uint8_t* dst = &outb[hdr_sz+i];
-			SHMIF_RGBA_DECOMP(inbuf[pos++], &dst[0], &dst[1], &dst[2], &dst[3]);
-			row_len--;
-			if (row_len == 0){
-				pos += vb->pitch - w;
-				row_len = w;
-			}
-		}
+		pack_span(a12int_pxpack_rgba,
+			vb, w, &pos, &row_len, &outb[hdr_sz], left / px_sz, px_sz);
 		a12int_append_out(S, STATE_VIDEO_PACKET, outb, hdr_sz + left, NULL, 0);
 	}
 
@@ -305,7 +340,6 @@ void a12int_encode_rgb(PACK_ARGS)
 	size_t bpb = ppb * px_sz;
 	size_t blocks = w * h / ppb;
 
-	shmif_pixel* inbuf = vb->buffer;
 	size_t pos = y * vb->pitch + x;
 
 /* get the packing buffer, cancel if oom */
@@ -330,16 +364,8 @@ void a12int_encode_rgb(PACK_ARGS)
 /* sweep the incoming frame, and pack maximum block size */
 	size_t row_len = w;
 	for (size_t i = 0; i < blocks; i++){
-		for (size_t j = 0; j < bpb; j += px_sz){
-			uint8_t ign;
-			uint8_t* dst = &outb[hdr_sz+j];
-			SHMIF_RGBA_DECOMP(inbuf[pos++], &dst[0], &dst[1], &dst[2], &ign);
-			row_len--;
-			if (row_len == 0){
-				pos += vb->pitch - w;
-				row_len = w;
-			}
-		}
+		pack_span(a12int_pxpack_rgb,
+			vb, w, &pos, &row_len, &outb[hdr_sz], ppb, px_sz);
 
 /* dispatch to out-queue(s) */
 		a12int_append_out(S, STATE_VIDEO_PACKET, outb, hdr_sz + bpb, NULL, 0);
@@ -349,22 +375,9 @@ void a12int_encode_rgb(PACK_ARGS)
  */
 	size_t bytes_left = ((w * h) - (blocks * ppb)) * px_sz;
 	if (bytes_left){
-		size_t ofs = 0;
 		pack_u16(bytes_left, &outb[5]);
-
-		while (bytes_left - ofs){
-			uint8_t ign;
-			uint8_t* dst = &outb[hdr_sz+ofs];
-			SHMIF_RGBA_DECOMP(inbuf[pos++], &dst[0], &dst[1], &dst[2], &ign);
-			ofs += px_sz;
-
-			row_len--;
-			if (row_len == 0){
-				pos += vb->pitch - w;
-				row_len = w;
-			}
-		}
-
+		pack_span(a12int_pxpack_rgb,
+			vb, w, &pos, &row_len, &outb[hdr_sz], bytes_left / px_sz, px_sz);
 		a12int_append_out(S, STATE_VIDEO_PACKET, outb, hdr_sz + bytes_left, NULL, 0);
 	}
 
@@ -378,12 +391,40 @@ static bool setup_zstd(struct a12_state* S, uint8_t ch)
 		if (!S->channels[ch].zstd){
 			return false;
 		}
-		ZSTD_CCtx_setParameter(S->channels[ch].zstd, ZSTD_c_nbWorkers, 4);
 	}
 
 	return true;
 }
 
+/*
+ * ZSTD_compressCCtx ignores the advanced parameters, so for multithreaded
+ * compression the level and worker count needs to be set on the context and
+ * go through compress2. Jobs are sized to split the input evenly.
+ */
+static size_t compress_video(struct a12_state* S, uint8_t ch,
+	void* dst, size_t dst_sz, const void* src, size_t src_sz, int level)
+{
+	struct ZSTD_CCtx_s* zstd = S->channels[ch].zstd;
+	size_t n_threads = S->opts ? S->opts->compression_threads : 0;
+
+	if (!n_threads || src_sz < ZSTD_MT_THRESHOLD)
+		return ZSTD_compressCCtx(zstd, dst, dst_sz, src, src_sz, level);
+
+	size_t job_sz = (src_sz + n_threads - 1) / n_threads;
+	if (job_sz < ZSTD_MT_THRESHOLD / 2)
+		job_sz = ZSTD_MT_THRESHOLD / 2;
+
+	ZSTD_CCtx_reset(zstd, ZSTD_reset_session_only);
+	ZSTD_CCtx_setParameter(zstd, ZSTD_c_compressionLevel, level);
+	ZSTD_CCtx_setParameter(zstd, ZSTD_c_nbWorkers, n_threads);
+	ZSTD_CCtx_setParameter(zstd, ZSTD_c_jobSize, job_sz);
+
+	a12int_trace(A12_TRACE_VDETAIL,
+		"kind=status:zstd_mt=%zu:job_sz=%zu:in=%zu", n_threads, job_sz, src_sz);
+
+	return ZSTD_compress2(zstd, dst, dst_sz, src, src_sz);
+}
+
 struct compress_res {
 	bool ok;
 	uint8_t type;
@@ -440,7 +481,7 @@ static void compress_tzstd(struct a12_state* S, uint8_t ch,
 	out_sz = ZSTD_compressBound(compress_in_sz);
 	buf = malloc(out_sz);
 
-	out_sz = ZSTD_compressCCtx(S->channels[ch].zstd,
+	out_sz = compress_video(S, ch,
 		buf, out_sz, vb->buffer_bytes, compress_in_sz, ZSTD_VIDEO_LEVEL);
 
 	if (ZSTD_isError(out_sz)){
@@ -501,8 +542,12 @@ static struct compress_res compress_deltaz(struct a12_state* S, uint8_t ch,
 		);
 		free(ab->buffer);
 		free(S->channels[ch].compression);
+		free(S->channels[ch].tiles.hash);
+		free(S->channels[ch].tiles.buf);
 		ab->buffer = NULL;
 		S->channels[ch].compression = NULL;
+		S->channels[ch].tiles.hash = NULL;
+		S->channels[ch].tiles.buf = NULL;
 	}
 
 	if (!setup_zstd(S, ch)){
@@ -520,7 +565,8 @@ static struct compress_res compress_deltaz(struct a12_state* S, uint8_t ch,
 		*x = 0;
 		*y = 0;
 		a12int_trace(A12_TRACE_VIDEO,
-			"kind=status:ch=%"PRIu8"compress=dpng:message=I", ch);
+			"kind=status:ch=%"PRIu8"compress=dpng:pack=%s:message=I",
+			ch, a12int_pxpack_impl());
 
 		if (!ab->buffer)
 			return (struct compress_res){};
@@ -542,14 +588,9 @@ static struct compress_res compress_deltaz(struct a12_state* S, uint8_t ch,
  * buffer do not have to be, thus we need to iterate and do this copy */
 		compress_in = (uint8_t*) ab->buffer;
 		uint8_t* acc = compress_in;
-		size_t ofs = 0;
 		for (size_t y = 0; y < vb->h; y++){
-			for (size_t x = 0; x < vb->w; x++){
-				uint8_t ign;
-				shmif_pixel px = vb->buffer[y*vb->pitch+x];
-				SHMIF_RGBA_DECOMP(px, &acc[ofs], &acc[ofs+1], &acc[ofs+2], &ign);
-				ofs += 3;
-			}
+			a12int_pxpack_rgb(&vb->buffer[y * vb->pitch], acc, vb->w);
+			acc += vb->w * 3;
 		}
 	}
 /* We have a delta frame, use accumulation buffer as a way to calculate a ^ b
@@ -564,21 +605,16 @@ static struct compress_res compress_deltaz(struct a12_state* S, uint8_t ch,
 		uint8_t* acc = (uint8_t*) ab->buffer;
 		for (size_t cy = (*y); cy < (*y)+(*h); cy++){
 			size_t rs = (cy * ab->w + (*x)) * 3;
-
-			for (size_t cx = *x; cx < (*x)+(*w); cx++){
-				uint8_t r, g, b, ign;
-				shmif_pixel px = vb->buffer[cy * vb->pitch + cx];
-				SHMIF_RGBA_DECOMP(px, &r, &g, &b, &ign);
-				compress_in[compress_in_sz++] = acc[rs+0] ^ r;
-				compress_in[compress_in_sz++] = acc[rs+1] ^ g;
-				compress_in[compress_in_sz++] = acc[rs+2] ^ b;
-				acc[rs+0] = r; acc[rs+1] = g; acc[rs+2] = b;
-				rs += 3;
-			}
+			a12int_pxpack_rgb_xor(&vb->buffer[cy * vb->pitch + (*x)],
+				&acc[rs], &compress_in[compress_in_sz], *w);
+			compress_in_sz += (*w) * 3;
 		}
 		type = POSTPROCESS_VIDEO_DZSTD;
 	}
 
+/* acc no longer matches what the tile hashes describe */
+	S->channels[ch].tiles.valid = false;
+
 	size_t out_sz;
 	uint8_t* buf;
 
@@ -587,8 +623,7 @@ static struct compress_res compress_deltaz(struct a12_state* S, uint8_t ch,
 	if (!buf)
 		return (struct compress_res){};
 
-	out_sz = ZSTD_compressCCtx(
-		S->channels[ch].zstd, buf, out_sz, compress_in, compress_in_sz, 1);
+	out_sz = compress_video(S, ch, buf, out_sz, compress_in, compress_in_sz, 1);
 
 	if (ZSTD_isError(out_sz)){
 		a12int_trace(A12_TRACE_ALLOC,
@@ -636,6 +671,146 @@ void a12int_encode_dzstd(PACK_ARGS)
 }
 
 
+/*
+ * Same reference as dzstd (the packed accumulation buffer) but the frame is
+ * split into A12_TILE_SIZE tiles that are hashed, and only the tiles whose
+ * hash changed are sent - so two small updates in opposite corners don't
+ * turn into a full frame bounding box.
+ */
+void a12int_encode_tiled(PACK_ARGS)
+{
+	struct shmifsrv_vbuffer* ab = &S->channels[chid].acc;
+
+/* no reference frame to patch against, dzstd will build it and send an I */
+	if (!ab->buffer || ab->w != vb->w || ab->h != vb->h){
+		a12int_encode_dzstd(FWD_ARGS);
+		return;
+	}
+
+	if (!setup_zstd(S, chid))
+		return;
+
+	size_t cols = (vb->w + A12_TILE_SIZE - 1) / A12_TILE_SIZE;
+	size_t rows = (vb->h + A12_TILE_SIZE - 1) / A12_TILE_SIZE;
+
+	if (!S->channels[chid].tiles.hash ||
+		S->channels[chid].tiles.cols != cols || S->channels[chid].tiles.rows != rows){
+		free(S->channels[chid].tiles.hash);
+		free(S->channels[chid].tiles.buf);
+
+/* worst case every tile changed, each with a 4 byte col/row prefix */
+		S->channels[chid].tiles.hash = malloc(cols * rows * sizeof(uint64_t));
+		S->channels[chid].tiles.buf = malloc(cols * rows * 4 + vb->w * vb->h * 3);
+		S->channels[chid].tiles.cols = cols;
+		S->channels[chid].tiles.rows = rows;
+		S->channels[chid].tiles.valid = false;
+
+		if (!S->channels[chid].tiles.hash || !S->channels[chid].tiles.buf){
+			a12int_trace(A12_TRACE_ALLOC, "kind=error:message=tile buffer alloc");
+			free(S->channels[chid].tiles.hash);
+			free(S->channels[chid].tiles.buf);
+			S->channels[chid].tiles.hash = NULL;
+			S->channels[chid].tiles.buf = NULL;
+			a12int_encode_dzstd(FWD_ARGS);
+			return;
+		}
+	}
+
+/* only tiles touching the dirty region can have changed, unless the hashes
+ * are stale and need to be rebuilt */
+	bool valid = S->channels[chid].tiles.valid;
+	size_t c1 = 0, r1 = 0, c2 = cols - 1, r2 = rows - 1;
+	if (valid){
+		c1 = x / A12_TILE_SIZE;
+		r1 = y / A12_TILE_SIZE;
+		c2 = (x + w - 1) / A12_TILE_SIZE;
+		r2 = (y + h - 1) / A12_TILE_SIZE;
+	}
+
+	uint64_t* hash = S->channels[chid].tiles.hash;
+	uint8_t* acc = (uint8_t*) ab->buffer;
+	uint8_t* out = S->channels[chid].tiles.buf;
+	size_t out_pos = 0;
+	size_t n_tiles = 0;
+	size_t bx1 = vb->w, by1 = vb->h, bx2 = 0, by2 = 0;
+
+	for (size_t row = r1; row <= r2; row++){
+		size_t ty = row * A12_TILE_SIZE;
+		size_t th = vb->h - ty < A12_TILE_SIZE ? vb->h - ty : A12_TILE_SIZE;
+
+		for (size_t col = c1; col <= c2; col++){
+			size_t tx = col * A12_TILE_SIZE;
+			size_t tw = vb->w - tx < A12_TILE_SIZE ? vb->w - tx : A12_TILE_SIZE;
+
+			uint64_t hv = 0;
+			for (size_t i = 0; i < th; i++){
+				hv = XXH64(&vb->buffer[(ty + i) * vb->pitch + tx],
+					tw * sizeof(shmif_pixel), hv);
+			}
+
+			if (valid && hash[row * cols + col] == hv)
+				continue;
+			hash[row * cols + col] = hv;
+
+			pack_u16(col, &out[out_pos]);
+			pack_u16(row, &out[out_pos+2]);
+			out_pos += 4;
+
+			for (size_t i = 0; i < th; i++){
+				a12int_pxpack_rgb_xor(&vb->buffer[(ty + i) * vb->pitch + tx],
+					&acc[((ty + i) * ab->w + tx) * 3], &out[out_pos], tw);
+				out_pos += tw * 3;
+			}
+
+			n_tiles++;
+			bx1 = tx < bx1 ? tx : bx1;
+			by1 = ty < by1 ? ty : by1;
+			bx2 = tx + tw > bx2 ? tx + tw : bx2;
+			by2 = ty + th > by2 ? ty + th : by2;
+		}
+	}
+
+	S->channels[chid].tiles.valid = true;
+
+/* nothing changed, still send the (empty) frame so the other end gets its
+ * commit and the stream ack/pacing stays consistent */
+	if (!n_tiles){
+		bx1 = by1 = bx2 = by2 = 0;
+	}
+
+	size_t out_sz = ZSTD_compressBound(out_pos);
+	uint8_t* buf = malloc(out_sz);
+	if (!buf)
+		return;
+
+	out_sz = compress_video(S, chid, buf, out_sz, out, out_pos, 1);
+	if (ZSTD_isError(out_sz)){
+		a12int_trace(A12_TRACE_ALLOC,
+			"kind=zstd_fail:message=%s", ZSTD_getErrorName(out_sz));
+		free(buf);
+		return;
+	}
+
+	a12int_trace(A12_TRACE_VDETAIL,
+		"kind=status:codec=tilezstd:tiles=%zu:total=%zu:b_in=%zu:b_out=%zu",
+		n_tiles, cols * rows, out_pos, out_sz
+	);
+
+	uint8_t hdr_buf[CONTROL_PACKET_SIZE];
+	a12int_vframehdr_build(hdr_buf, S->last_seen_seqnr, chid,
+		POSTPROCESS_VIDEO_TILEZSTD, sid, vb->w, vb->h,
+		bx2 - bx1, by2 - by1, bx1, by1, out_sz, out_pos, 1, vb->flags.origo_ll
+	);
+
+	a12int_step_vstream(S, sid);
+	a12int_append_out(S,
+		STATE_CONTROL_PACKET, hdr_buf, CONTROL_PACKET_SIZE, NULL, 0);
+	chunk_pack(S, STATE_VIDEO_PACKET, chid, buf, out_sz, chunk_sz);
+
+	free(buf);
+}
+
+
 void a12int_encode_dpng(PACK_ARGS)
 {
 	struct compress_res cres = compress_deltaz(S, chid, vb, &x, &y, &w, &h, false);
@@ -18,6 +18,7 @@ void a12int_encode_dpng(PACK_ARGS);
 void a12int_encode_h264(PACK_ARGS);
 void a12int_encode_tz(PACK_ARGS);
 void a12int_encode_dzstd(PACK_ARGS);
+void a12int_encode_tiled(PACK_ARGS);
 void a12int_encode_ztz(PACK_ARGS);
 void a12int_encode_passthrough(PACK_ARGS);
 void a12int_encode_drop(struct a12_state* S, int chid, bool failed);
@@ -30,4 +31,12 @@ void a12int_encode_araw(struct a12_state* S,
 	struct a12_aframe_opts opts, size_t chunk_sz
 );
 
+void a12int_encode_aadpcm(struct a12_state* S,
+	uint8_t chid,
+	shmif_asample* buf,
+	uint16_t n_samples,
+	struct a12_aframe_cfg cfg,
+	struct a12_aframe_opts opts, size_t chunk_sz
+);
+
 #endif
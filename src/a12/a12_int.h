@@ -22,6 +22,17 @@
 #define ZSTD_VIDEO_LEVEL 2
 #endif
 
+/* inputs smaller than this are always compressed single-threaded, zstd
+ * won't split jobs smaller than 512k anyhow */
+#ifndef ZSTD_MT_THRESHOLD
+#define ZSTD_MT_THRESHOLD (1024 * 1024)
+#endif
+
+/* a12int_append_out ciphers and MACs payloads in chunks of this size */
+#ifndef APPEND_CHUNK_SZ
+#define APPEND_CHUNK_SZ 8192
+#endif
+
 #ifndef VIDEO_FRAME_DRIFT_WINDOW
 #define VIDEO_FRAME_DRIFT_WINDOW 8
 #endif
@@ -35,6 +46,25 @@
 #define BLOB_QUEUE_CAP (128 * 1024)
 #endif
 
+/* when this many bytes are already waiting in the output buffer, audio and
+ * video packets are held back in their outbound queues so that control and
+ * input can overtake them - this is also the most that a flush moves out */
+#ifndef OUTQ_DIRECT_CAP
+#define OUTQ_DIRECT_CAP (64 * 1024)
+#endif
+
+/* past this many bytes of queued video, new frames are dropped and their
+ * region merged into the next one that gets through */
+#ifndef OUTQ_VIDEO_DROP
+#define OUTQ_VIDEO_DROP (4 * 1024 * 1024)
+#endif
+
+/* blob data that still gets appended on each flush while audio / video is
+ * waiting in the output buffer, so that transfers can't starve behind it */
+#ifndef OUTQ_BLOB_BUDGET
+#define OUTQ_BLOB_BUDGET (16 * 1024)
+#endif
+
 /* safe UDP beacon, increase in controlled LANs */
 #ifndef BEACON_KEY_CAP
 #define BEACON_KEY_CAP 15
@@ -92,6 +122,14 @@ enum hello_mode {
 	HELLO_MODE_EPHEMPK = 2
 };
 
+/* optional decoding capabilities announced in the hello, a sender only uses
+ * the corresponding encoding if the other side has the bit set */
+enum hello_feature {
+	HELLO_FEATURE_AUDIO_ADPCM = 1
+};
+
+#define HELLO_FEATURES (HELLO_FEATURE_AUDIO_ADPCM)
+
 enum channel_cfg {
 	CHANNEL_INACTIVE = 0, /* nothing mapped in the channel          */
 	CHANNEL_SHMIF    = 1, /* shmif context set                      */
@@ -113,9 +151,20 @@ enum {
 	POSTPROCESS_VIDEO_H264   = 5, /* ffmpeg or native decompressor        */
 	POSTPROCESS_VIDEO_TZSTD  = 7, /* ZSTD+tpack                           */
 	POSTPROCESS_VIDEO_DZSTD  = 8, /* ZSTD - P frame                       */
-	POSTPROCESS_VIDEO_ZSTD   = 9  /* ZSTD - I frame                       */
+	POSTPROCESS_VIDEO_ZSTD   = 9, /* ZSTD - I frame                       */
+	POSTPROCESS_VIDEO_TILEZSTD = 10 /* ZSTD - P frame, [u16 col, u16 row,
+	                                   tile ^ ref.] for each changed tile   */
 };
 
+enum {
+	POSTPROCESS_AUDIO_S16    = 0,
+	POSTPROCESS_AUDIO_ADPCM  = 1  /* a12_adpcm.h block per audio packet   */
+};
+
+/* width and height of a tile in POSTPROCESS_VIDEO_TILEZSTD, edge tiles are
+ * clipped against the surface dimensions */
+#define A12_TILE_SIZE 32
+
 size_t a12int_header_size(int type);
 
 struct ZSTD_CCtx_s;
@@ -160,7 +209,7 @@ struct video_frame {
 	uint8_t postprocess;
 	uint8_t commit; /* finish after this transfer? */
 
-	uint8_t* inbuf; /* decode buffer, not used for all modes */
+	uint8_t* inbuf; /* decode buffer (channel varena), not used for all modes */
 	uint32_t inbuf_pos;
 	uint32_t inbuf_sz; /* bytes-total counter */
  /* separation between input-frame buffer and
@@ -184,11 +233,32 @@ struct video_frame {
 	} ffmpeg;
 #endif
 
-	struct ZSTD_DCtx_s* zstd;
-
 	/* bytes left on current row for raw-dec */
 };
 
+/*
+ * Outbound traffic classes in priority order, blobs are not part of this as
+ * they are pulled in on flush, up to OUTQ_BLOB_BUDGET when something else is
+ * already waiting.
+ */
+enum outq_class {
+	OUTQ_CONTROL = 0, /* control and events, never held back */
+	OUTQ_AUDIO   = 1,
+	OUTQ_VIDEO   = 2,
+	OUTQ_COUNT   = 3
+};
+
+/* plaintext packet held back in an outbound queue, [buf] has room for the
+ * outer frame header followed by prepend + data, ciphering happens in place
+ * or while it is moved to the output buffer */
+struct outq_packet {
+	uint8_t type;
+	size_t prepend_sz;
+	size_t data_sz;
+	struct outq_packet* next;
+	uint8_t buf[];
+};
+
 struct blob_out;
 struct blob_out {
 	uint8_t checksum[16];
@@ -224,9 +294,44 @@ struct a12_channel {
 /* used for both encoding and decoding, state is aliased into unpack_state */
 	struct shmifsrv_vbuffer acc;
 
+/* region of video frames dropped due to outbound backlog, merged into the
+ * next frame that is encoded */
+	struct {
+		bool pending;
+		size_t x1, y1, x2, y2;
+	} vdrop;
+
+/* grow-only buffers kept between received video frames, [in] collects the
+ * compressed frame and [out] holds it decompressed when that can't be done
+ * straight into the destination */
+	struct {
+		uint8_t* in;
+		size_t in_sz;
+		uint8_t* out;
+		size_t out_sz;
+		struct ZSTD_DCtx_s* zstd;
+	} varena;
+
+/* reused between audio frames for packing outbound and decoding inbound
+ * samples, [index] is the ADPCM step index carried between blocks */
+	struct {
+		uint8_t* buf;
+		size_t buf_sz;
+		uint8_t index[8]; /* A12_ADPCM_MAX_CHANNELS */
+	} apack;
+
 	struct {
 		uint8_t* compression;
 		struct ZSTD_CCtx_s* zstd;
+
+/* content hash of each tile in acc, only valid if the last update to acc
+ * came from the tile encoder */
+		struct {
+			uint64_t* hash;
+			uint8_t* buf;
+			size_t cols, rows;
+			bool valid;
+		} tiles;
 #if defined(WANT_H264_ENC) || defined(WANT_H264_DEC)
 		struct {
 			AVCodecParserContext* parser;
@@ -285,6 +390,18 @@ struct a12_state {
 	uint8_t buf_ind;
 	size_t buf_ofs;
 
+/* class (enum outq_class) of packets currently being appended, and the ones
+ * held back until the output buffer has been flushed */
+	int out_class;
+	struct {
+		struct outq_packet* first;
+		struct outq_packet* last;
+		size_t bytes;
+	} outq[OUTQ_COUNT];
+
+/* sealed packet handed out by the last a12_flush, freed on the next one */
+	struct outq_packet* outq_sent;
+
 /* linked list of pending binary transfers, can be re-ordered and affect
  * blocking / transfer state of events on the other side */
 	struct blob_out* pending;
@@ -346,6 +463,7 @@ struct a12_state {
 	bool cl_firstout;
 	int authentic;
 	int remote_mode;
+	uint8_t remote_features;
 	char* endpoint;
 
 /* saved between calls to unpack, see end of a12_unpack for explanation */
@@ -374,6 +492,9 @@ void a12int_append_out(
 
 void a12int_step_vstream(struct a12_state* S, uint32_t id);
 
+/* get the reusable audio packing buffer of [chid] with room for [sz] bytes */
+uint8_t* a12int_apack_buffer(struct a12_state* S, uint8_t chid, size_t sz);
+
 /* takes ownership of appl_meta */
 void a12int_set_directory(struct a12_state*, struct appl_meta*);
 
@@ -0,0 +1,411 @@
+/*
+ * Copyright: Björn Ståhl
+ * Description: A12 protocol, pixel repacking kernels for the video encoders
+ * License: 3-Clause BSD, see COPYING file in arcan source repository.
+ * Reference: https://arcan-fe.com
+ */
+#include <arcan_shmif.h>
+#include <pthread.h>
+
+#include "a12_pxpack.h"
+
+/*
+ * The vector versions hardcode the default shmif packing (b, g, r, a in
+ * memory), anything else will have to go through the DECOMP macro.
+ */
+#if SHMIF_RGBA_RSHIFT == 16 && SHMIF_RGBA_GSHIFT == 8 &&\
+	SHMIF_RGBA_BSHIFT == 0 && SHMIF_RGBA_ASHIFT == 24 &&\
+	defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PXPACK_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define PXPACK_NEON
+#include <arm_neon.h>
+#endif
+
+#endif
+
+static void rgba_scalar(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	for (size_t i = 0; i < n; i++, out += 4)
+		SHMIF_RGBA_DECOMP(in[i], &out[0], &out[1], &out[2], &out[3]);
+}
+
+static void rgb_scalar(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	for (size_t i = 0; i < n; i++, out += 3){
+		uint8_t ign;
+		SHMIF_RGBA_DECOMP(in[i], &out[0], &out[1], &out[2], &ign);
+	}
+}
+
+static void rgb565_scalar(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	for (size_t i = 0; i < n; i++, out += 2){
+		uint8_t r, g, b, ign;
+		SHMIF_RGBA_DECOMP(in[i], &r, &g, &b, &ign);
+		uint16_t px =
+			(((b >> 3) & 0x1f) << 0) |
+			(((g >> 2) & 0x3f) << 5) |
+			(((r >> 3) & 0x1f) << 11)
+		;
+		out[0] = (uint8_t)(px >> 0);
+		out[1] = (uint8_t)(px >> 8);
+	}
+}
+
+static void rgb_xor_scalar(
+	const shmif_pixel* in, uint8_t* acc, uint8_t* out, size_t n)
+{
+	for (size_t i = 0; i < n; i++, acc += 3, out += 3){
+		uint8_t r, g, b, ign;
+		SHMIF_RGBA_DECOMP(in[i], &r, &g, &b, &ign);
+		out[0] = acc[0] ^ r;
+		out[1] = acc[1] ^ g;
+		out[2] = acc[2] ^ b;
+		acc[0] = r; acc[1] = g; acc[2] = b;
+	}
+}
+
+#ifdef PXPACK_X86
+/*
+ * The rgb versions store a full register but only advance 12 (24) bytes, so
+ * they stop early enough that the last store stays inside the n * 3 output,
+ * the scalar version takes the remainder. For the accumulator, the bytes past
+ * the packed part are written back unchanged since they have not been read.
+ */
+#define SSE_RGBA_MASK \
+	_mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15)
+
+#define SSE_RGB_MASK \
+	_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+
+__attribute__((target("ssse3")))
+static void rgba_ssse3(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	__m128i mask = SSE_RGBA_MASK;
+	size_t i = 0;
+
+	for (; i + 4 <= n; i += 4){
+		__m128i v = _mm_loadu_si128((const __m128i*) &in[i]);
+		_mm_storeu_si128((__m128i*) &out[i * 4], _mm_shuffle_epi8(v, mask));
+	}
+
+	rgba_scalar(&in[i], &out[i * 4], n - i);
+}
+
+__attribute__((target("ssse3")))
+static void rgb_ssse3(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	__m128i mask = SSE_RGB_MASK;
+	size_t i = 0;
+
+	for (; i + 6 <= n; i += 4){
+		__m128i v = _mm_loadu_si128((const __m128i*) &in[i]);
+		_mm_storeu_si128((__m128i*) &out[i * 3], _mm_shuffle_epi8(v, mask));
+	}
+
+	rgb_scalar(&in[i], &out[i * 3], n - i);
+}
+
+__attribute__((target("ssse3")))
+static void rgb_xor_ssse3(
+	const shmif_pixel* in, uint8_t* acc, uint8_t* out, size_t n)
+{
+	__m128i mask = SSE_RGB_MASK;
+	__m128i keep = _mm_setr_epi32(0, 0, 0, -1);
+	size_t i = 0;
+
+	for (; i + 6 <= n; i += 4){
+		__m128i v = _mm_shuffle_epi8(
+			_mm_loadu_si128((const __m128i*) &in[i]), mask);
+		__m128i a = _mm_loadu_si128((const __m128i*) &acc[i * 3]);
+
+		_mm_storeu_si128((__m128i*) &out[i * 3], _mm_xor_si128(v, a));
+		_mm_storeu_si128((__m128i*) &acc[i * 3],
+			_mm_or_si128(v, _mm_and_si128(a, keep)));
+	}
+
+	rgb_xor_scalar(&in[i], &acc[i * 3], &out[i * 3], n - i);
+}
+
+/* r5g6b5 in the low half of each 32-bit lane, sign extended so that the
+ * signed saturating pack doesn't clamp values with the top bit set */
+__attribute__((target("ssse3")))
+static inline __m128i sse_565(__m128i v)
+{
+	__m128i r = _mm_and_si128(_mm_srli_epi32(v, 8), _mm_set1_epi32(0xf800));
+	__m128i g = _mm_and_si128(_mm_srli_epi32(v, 5), _mm_set1_epi32(0x07e0));
+	__m128i b = _mm_and_si128(_mm_srli_epi32(v, 3), _mm_set1_epi32(0x001f));
+	__m128i px = _mm_or_si128(r, _mm_or_si128(g, b));
+	return _mm_srai_epi32(_mm_slli_epi32(px, 16), 16);
+}
+
+__attribute__((target("ssse3")))
+static void rgb565_ssse3(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= n; i += 8){
+		__m128i lo = sse_565(_mm_loadu_si128((const __m128i*) &in[i]));
+		__m128i hi = sse_565(_mm_loadu_si128((const __m128i*) &in[i + 4]));
+		_mm_storeu_si128((__m128i*) &out[i * 2], _mm_packs_epi32(lo, hi));
+	}
+
+	rgb565_scalar(&in[i], &out[i * 2], n - i);
+}
+
+/*
+ * AVX2 shuffles work per 128-bit lane, so the rgb versions pack 12 bytes in
+ * each lane and then move the upper lane down to close the gap.
+ */
+#define AVX_RGBA_MASK _mm256_setr_epi8(\
+	2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,\
+	2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15)
+
+#define AVX_RGB_MASK _mm256_setr_epi8(\
+	2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,\
+	2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+
+#define AVX_RGB_COMPACT _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7)
+
+__attribute__((target("avx2")))
+static void rgba_avx2(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	__m256i mask = AVX_RGBA_MASK;
+	size_t i = 0;
+
+	for (; i + 8 <= n; i += 8){
+		__m256i v = _mm256_loadu_si256((const __m256i*) &in[i]);
+		_mm256_storeu_si256((__m256i*) &out[i * 4], _mm256_shuffle_epi8(v, mask));
+	}
+
+	rgba_scalar(&in[i], &out[i * 4], n - i);
+}
+
+__attribute__((target("avx2")))
+static void rgb_avx2(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	__m256i mask = AVX_RGB_MASK;
+	__m256i compact = AVX_RGB_COMPACT;
+	size_t i = 0;
+
+	for (; i + 11 <= n; i += 8){
+		__m256i v = _mm256_shuffle_epi8(
+			_mm256_loadu_si256((const __m256i*) &in[i]), mask);
+		_mm256_storeu_si256((__m256i*) &out[i * 3],
+			_mm256_permutevar8x32_epi32(v, compact));
+	}
+
+	rgb_scalar(&in[i], &out[i * 3], n - i);
+}
+
+__attribute__((target("avx2")))
+static void rgb_xor_avx2(
+	const shmif_pixel* in, uint8_t* acc, uint8_t* out, size_t n)
+{
+	__m256i mask = AVX_RGB_MASK;
+	__m256i compact = AVX_RGB_COMPACT;
+	__m256i keep = _mm256_setr_epi32(0, 0, 0, 0, 0, 0, -1, -1);
+	size_t i = 0;
+
+	for (; i + 11 <= n; i += 8){
+		__m256i v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(
+			_mm256_loadu_si256((const __m256i*) &in[i]), mask), compact);
+		__m256i a = _mm256_loadu_si256((const __m256i*) &acc[i * 3]);
+
+		_mm256_storeu_si256((__m256i*) &out[i * 3], _mm256_xor_si256(v, a));
+		_mm256_storeu_si256((__m256i*) &acc[i * 3],
+			_mm256_or_si256(v, _mm256_and_si256(a, keep)));
+	}
+
+	rgb_xor_scalar(&in[i], &acc[i * 3], &out[i * 3], n - i);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx_565(__m256i v)
+{
+	__m256i r = _mm256_and_si256(
+		_mm256_srli_epi32(v, 8), _mm256_set1_epi32(0xf800));
+	__m256i g = _mm256_and_si256(
+		_mm256_srli_epi32(v, 5), _mm256_set1_epi32(0x07e0));
+	__m256i b = _mm256_and_si256(
+		_mm256_srli_epi32(v, 3), _mm256_set1_epi32(0x001f));
+	__m256i px = _mm256_or_si256(r, _mm256_or_si256(g, b));
+	return _mm256_srai_epi32(_mm256_slli_epi32(px, 16), 16);
+}
+
+__attribute__((target("avx2")))
+static void rgb565_avx2(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= n; i += 16){
+		__m256i lo = avx_565(_mm256_loadu_si256((const __m256i*) &in[i]));
+		__m256i hi = avx_565(_mm256_loadu_si256((const __m256i*) &in[i + 8]));
+
+/* the pack interleaves the lanes of lo and hi, restore the order */
+		__m256i px = _mm256_permute4x64_epi64(
+			_mm256_packs_epi32(lo, hi), 0xd8);
+		_mm256_storeu_si256((__m256i*) &out[i * 2], px);
+	}
+
+	rgb565_scalar(&in[i], &out[i * 2], n - i);
+}
+#endif
+
+#ifdef PXPACK_NEON
+/*
+ * The structured loads deinterleave the channels for us (b, g, r, a in
+ * val[0..3]) and the structured stores write them back in the order we want.
+ */
+static void rgba_neon(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= n; i += 16){
+		uint8x16x4_t v = vld4q_u8((const uint8_t*) &in[i]);
+		uint8x16x4_t o = {{v.val[2], v.val[1], v.val[0], v.val[3]}};
+		vst4q_u8(&out[i * 4], o);
+	}
+
+	rgba_scalar(&in[i], &out[i * 4], n - i);
+}
+
+static void rgb_neon(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= n; i += 16){
+		uint8x16x4_t v = vld4q_u8((const uint8_t*) &in[i]);
+		uint8x16x3_t o = {{v.val[2], v.val[1], v.val[0]}};
+		vst3q_u8(&out[i * 3], o);
+	}
+
+	rgb_scalar(&in[i], &out[i * 3], n - i);
+}
+
+static void rgb_xor_neon(
+	const shmif_pixel* in, uint8_t* acc, uint8_t* out, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= n; i += 16){
+		uint8x16x4_t v = vld4q_u8((const uint8_t*) &in[i]);
+		uint8x16x3_t a = vld3q_u8(&acc[i * 3]);
+		uint8x16x3_t p = {{v.val[2], v.val[1], v.val[0]}};
+		uint8x16x3_t o = {{
+			veorq_u8(a.val[0], p.val[0]),
+			veorq_u8(a.val[1], p.val[1]),
+			veorq_u8(a.val[2], p.val[2])
+		}};
+		vst3q_u8(&out[i * 3], o);
+		vst3q_u8(&acc[i * 3], p);
+	}
+
+	rgb_xor_scalar(&in[i], &acc[i * 3], &out[i * 3], n - i);
+}
+
+static inline uint16x8_t neon_565(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+	uint16x8_t r16 = vshlq_n_u16(vmovl_u8(vshr_n_u8(r, 3)), 11);
+	uint16x8_t g16 = vshlq_n_u16(vmovl_u8(vshr_n_u8(g, 2)), 5);
+	uint16x8_t b16 = vmovl_u8(vshr_n_u8(b, 3));
+	return vorrq_u16(r16, vorrq_u16(g16, b16));
+}
+
+static void rgb565_neon(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	size_t i = 0;
+
+	for (; i + 16 <= n; i += 16){
+		uint8x16x4_t v = vld4q_u8((const uint8_t*) &in[i]);
+		uint16x8_t lo = neon_565(vget_low_u8(v.val[2]),
+			vget_low_u8(v.val[1]), vget_low_u8(v.val[0]));
+		uint16x8_t hi = neon_565(vget_high_u8(v.val[2]),
+			vget_high_u8(v.val[1]), vget_high_u8(v.val[0]));
+		vst1q_u8(&out[i * 2], vreinterpretq_u8_u16(lo));
+		vst1q_u8(&out[i * 2 + 16], vreinterpretq_u8_u16(hi));
+	}
+
+	rgb565_scalar(&in[i], &out[i * 2], n - i);
+}
+#endif
+
+static struct {
+	const char* name;
+	void (*rgba)(const shmif_pixel*, uint8_t*, size_t);
+	void (*rgb)(const shmif_pixel*, uint8_t*, size_t);
+	void (*rgb565)(const shmif_pixel*, uint8_t*, size_t);
+	void (*rgb_xor)(const shmif_pixel*, uint8_t*, uint8_t*, size_t);
+} impl = {
+	.name = "scalar",
+	.rgba = rgba_scalar,
+	.rgb = rgb_scalar,
+	.rgb565 = rgb565_scalar,
+	.rgb_xor = rgb_xor_scalar
+};
+
+static pthread_once_t impl_once = PTHREAD_ONCE_INIT;
+
+static void impl_select()
+{
+#ifdef PXPACK_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")){
+		impl.name = "avx2";
+		impl.rgba = rgba_avx2;
+		impl.rgb = rgb_avx2;
+		impl.rgb565 = rgb565_avx2;
+		impl.rgb_xor = rgb_xor_avx2;
+	}
+	else if (__builtin_cpu_supports("ssse3")){
+		impl.name = "ssse3";
+		impl.rgba = rgba_ssse3;
+		impl.rgb = rgb_ssse3;
+		impl.rgb565 = rgb565_ssse3;
+		impl.rgb_xor = rgb_xor_ssse3;
+	}
+#endif
+
+#ifdef PXPACK_NEON
+	impl.name = "neon";
+	impl.rgba = rgba_neon;
+	impl.rgb = rgb_neon;
+	impl.rgb565 = rgb565_neon;
+	impl.rgb_xor = rgb_xor_neon;
+#endif
+}
+
+void a12int_pxpack_rgba(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	pthread_once(&impl_once, impl_select);
+	impl.rgba(in, out, n);
+}
+
+void a12int_pxpack_rgb(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	pthread_once(&impl_once, impl_select);
+	impl.rgb(in, out, n);
+}
+
+void a12int_pxpack_rgb565(const shmif_pixel* in, uint8_t* out, size_t n)
+{
+	pthread_once(&impl_once, impl_select);
+	impl.rgb565(in, out, n);
+}
+
+void a12int_pxpack_rgb_xor(
+	const shmif_pixel* in, uint8_t* acc, uint8_t* out, size_t n)
+{
+	pthread_once(&impl_once, impl_select);
+	impl.rgb_xor(in, acc, out, n);
+}
+
+const char* a12int_pxpack_impl()
+{
+	pthread_once(&impl_once, impl_select);
+	return impl.name;
+}
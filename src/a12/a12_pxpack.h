@@ -0,0 +1,35 @@
+#ifndef HAVE_A12_PXPACK
+#define HAVE_A12_PXPACK
+
+/*
+ * Pixel repacking kernels used by the raw and delta video encoders. The
+ * implementation is picked on first use based on what the CPU supports, with
+ * a scalar version as fallback (and as the only option if the shmif pixel
+ * layout has been overridden at build time).
+ *
+ * All kernels take [n] source pixels and produce n * 4 (rgba), n * 3 (rgb)
+ * or n * 2 (rgb565, little endian) bytes of output.
+ */
+
+/* [in] -> [out] as r, g, b, a */
+void a12int_pxpack_rgba(const shmif_pixel* in, uint8_t* out, size_t n);
+
+/* [in] -> [out] as r, g, b */
+void a12int_pxpack_rgb(const shmif_pixel* in, uint8_t* out, size_t n);
+
+/* [in] -> [out] as r5 g6 b5 */
+void a12int_pxpack_rgb565(const shmif_pixel* in, uint8_t* out, size_t n);
+
+/*
+ * [in] packed as r, g, b and xored against the previous contents of [acc]
+ * into [out], [acc] is then updated with the packed [in]
+ */
+void a12int_pxpack_rgb_xor(
+	const shmif_pixel* in, uint8_t* acc, uint8_t* out, size_t n);
+
+/*
+ * name of the selected implementation, for tracing
+ */
+const char* a12int_pxpack_impl();
+
+#endif
@@ -129,21 +129,139 @@ static void chacha_counter_set(
 	chacha_block(ctx, ctx->keystream.u32);
 }
 
-static void chacha_apply(
-	struct chacha_ctx *ctx, uint8_t* buf, size_t length)
+/*
+ * Four consecutive blocks computed side by side, one block per vector lane,
+ * the output is the same as four chacha_block calls would produce.
+ */
+#if defined(__GNUC__)
+typedef uint32_t chacha_v4 __attribute__((vector_size(16)));
+
+static void chacha_block4(struct chacha_ctx* ctx, uint8_t output[256])
 {
-	if (!length)
-		return;
+	chacha_v4 in[16], x[16];
+	for (size_t i = 0; i < 16; i++){
+		uint32_t v = ctx->schedule[i];
+		in[i] = (chacha_v4){v, v, v, v};
+	}
+
+/* same 128-bit counter increment as chacha_block, but per lane */
+	uint32_t* const nonce = &ctx->schedule[counter_pos];
+	for (size_t lane = 0; lane < 4; lane++){
+		for (size_t i = 0; i < 4; i++)
+			in[counter_pos + i][lane] = nonce[i];
+
+		if (!++nonce[0] && !++nonce[1] && !++nonce[2]){
+			++nonce[3];
+		}
+	}
+
+	memcpy(x, in, sizeof(x));
+	int i = ctx->iterations;
+	while (i--){
+		QUARTERROUND(x, 0, 4, 8, 12)
+		QUARTERROUND(x, 1, 5, 9, 13)
+		QUARTERROUND(x, 2, 6, 10, 14)
+		QUARTERROUND(x, 3, 7, 11, 15)
+		QUARTERROUND(x, 0, 5, 10, 15)
+		QUARTERROUND(x, 1, 6, 11, 12)
+		QUARTERROUND(x, 2, 7, 8, 13)
+		QUARTERROUND(x, 3, 4, 9, 14)
+	}
+
+	uint32_t res[16][4];
+	for (size_t j = 0; j < 16; j++){
+		x[j] += in[j];
+		memcpy(res[j], &x[j], sizeof(res[j]));
+	}
+
+	for (size_t lane = 0; lane < 4; lane++){
+		for (size_t j = 0; j < 16; j++){
+			uint32_t v = res[j][lane];
+			FROMLE(&output[lane * 64 + j * 4], v);
+		}
+	}
+}
+#else
+/* chacha_block resets the keystream position, the vector version leaves it
+ * alone and callers rely on that, and output has no alignment guarantee */
+static void chacha_block4(struct chacha_ctx* ctx, uint8_t output[256])
+{
+	size_t pos = ctx->pos;
+	uint32_t block[16];
+
+	for (size_t i = 0; i < 4; i++){
+		chacha_block(ctx, block);
+		memcpy(&output[i * 64], block, sizeof(block));
+	}
+
+	ctx->pos = pos;
+}
+#endif
 
+static void chacha_xor(
+	uint8_t* dst, const uint8_t* src, const uint8_t* ks, size_t length)
+{
 	size_t ofs = 0;
-	while(ofs < length){
-		if (ctx->pos == 64)
-			chacha_block(ctx, ctx->keystream.u32);
+	for (; ofs + 8 <= length; ofs += 8){
+		uint64_t a, b;
+		memcpy(&a, &src[ofs], 8);
+		memcpy(&b, &ks[ofs], 8);
+		a ^= b;
+		memcpy(&dst[ofs], &a, 8);
+	}
 
+	for (; ofs < length; ofs++)
+		dst[ofs] = src[ofs] ^ ks[ofs];
+}
+
+/*
+ * Encrypt [length] bytes from [src] into [dst] (which may be the same buffer)
+ * so that copying into an output buffer and ciphering is one pass rather than
+ * two. Whole blocks are taken from a batch of keystream rather than from the
+ * ctx- keystream block a byte at a time.
+ */
+static void chacha_apply_copy(struct chacha_ctx *ctx,
+	uint8_t* dst, const uint8_t* src, size_t length)
+{
+	size_t ofs = 0;
+
+/* drain what is left of the current keystream block */
+	if (ctx->pos < 64){
 		size_t nib = 64 - ctx->pos;
-		while (nib && ofs < length){
-			buf[ofs] ^= ctx->keystream.u8[ctx->pos++];
-			nib--, ofs++;
-		}
+		if (nib > length)
+			nib = length;
+
+		chacha_xor(dst, src, &ctx->keystream.u8[ctx->pos], nib);
+		ctx->pos += nib;
+		ofs = nib;
+	}
+
+	uint8_t batch[256];
+	while (length - ofs >= sizeof(batch)){
+		chacha_block4(ctx, batch);
+		chacha_xor(&dst[ofs], &src[ofs], batch, sizeof(batch));
+		ofs += sizeof(batch);
 	}
+
+/* and the tail goes through the regular keystream block */
+	while (ofs < length){
+		chacha_block(ctx, ctx->keystream.u32);
+
+		size_t nib = length - ofs;
+		if (nib > 64)
+			nib = 64;
+
+		chacha_xor(&dst[ofs], &src[ofs], ctx->keystream.u8, nib);
+		ctx->pos = nib;
+		ofs += nib;
+	}
+}
+
+static void chacha_apply(
+	struct chacha_ctx *ctx, uint8_t* buf, size_t length)
+{
+	if (!length)
+		return;
+
+	chacha_apply_copy(ctx, buf, buf, length);
 }
@@ -47,6 +47,11 @@ struct a12helper_opts {
 
 /* opendir to populate with b64[checksum] for fonts and other cacheables */
 	int bcache_dir;
+
+/* a12cl_shmifsrv- specific: forward client audio and with which method, the
+ * method falls back to RAW if the other side doesn't support it */
+	bool audio;
+	enum a12_aframe_method aframe_method;
 };
 
 /*
@@ -435,15 +435,17 @@ static void on_srv_event(
 static void on_audio_cb(shmif_asample* buf,
 	size_t n_samples,  unsigned channels, unsigned rate, void* tag)
 {
-	return;
-	struct a12_state* S = tag;
-	a12_channel_aframe(S, buf, n_samples,
+	struct shmifsrv_thread_data* data = tag;
+	if (!data->opts.audio)
+		return;
+
+	a12_channel_aframe(data->S, buf, n_samples,
 		(struct a12_aframe_cfg){
 			.channels = channels,
 			.samplerate = rate
 		},
 		(struct a12_aframe_opts){
-			.method = AFRAME_METHOD_RAW
+			.method = data->opts.aframe_method
 		}
 	);
 }
@@ -580,9 +582,10 @@ static void* client_thread(void* inarg)
 				END_CRITICAL(&giant_lock);
 				stat = a12_state_iostat(data->S);
 				a12int_trace(A12_TRACE_VDETAIL,
-					"vbuffer=release:time_ms=%zu:time_ms_px=%.4f:congestion=%zu",
+					"vbuffer=release:time_ms=%zu:time_ms_px=%.4f:congestion=%zu:"
+					"queued=%zu:dropped=%zu",
 					stat.ms_vframe, stat.ms_vframe_px,
-					stat.vframe_backpressure
+					stat.vframe_backpressure, stat.out_queue_video, stat.vframe_dropped
 				);
 
 /* the other part is to, after a certain while of VBUFFER_READY but not any
@@ -599,7 +602,7 @@ static void* client_thread(void* inarg)
 				a12int_trace(A12_TRACE_AUDIO, "audio-buffer");
 				BEGIN_CRITICAL(&giant_lock, "audio_buffer");
 					a12_set_channel(data->S, data->chid);
-					shmifsrv_audio(data->C, on_audio_cb, data->S);
+					shmifsrv_audio(data->C, on_audio_cb, data);
 					dirty = true;
 				END_CRITICAL(&giant_lock);
 			}
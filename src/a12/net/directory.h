@@ -124,6 +124,8 @@ struct global_cfg {
 	size_t accept_n_pk_unknown;
 	size_t backpressure;
 	size_t backpressure_soft;
+	bool audio;
+	enum a12_aframe_method aframe_method;
 	int directory;
 	struct anet_dirsrv_opts dirsrv;
 	struct anet_dircl_opts dircl;
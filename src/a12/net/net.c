@@ -281,6 +281,8 @@ static void fork_a12srv(struct a12_state* S, int fd, void* tag)
 			.vframe_block = global.backpressure,
 			.vframe_soft_block = global.backpressure_soft,
 			.eval_vcodec = vcodec_tuning,
+			.audio = global.audio,
+			.aframe_method = global.aframe_method,
 			.bcache_dir = get_bcache_dir()
 		});
 		shmifsrv_free(C, SHMIFSRV_FREE_NO_DMS);
@@ -392,6 +394,8 @@ static void single_a12srv(struct a12_state* S, int fd, void* tag)
 			.vframe_block = global.backpressure,
 			.vframe_soft_block = global.backpressure_soft,
 			.eval_vcodec = vcodec_tuning,
+			.audio = global.audio,
+			.aframe_method = global.aframe_method,
 			.bcache_dir = get_bcache_dir()
 		});
 		shmifsrv_free(C, SHMIFSRV_FREE_NO_DMS);
@@ -445,6 +449,8 @@ static void a12cl_dispatch(
 /* note that the a12helper will do the cleanup / free */
 		a12helper_a12cl_shmifsrv(S, cl, fd, fd, (struct a12helper_opts){
 			.vframe_block = global.backpressure,
+			.audio = global.audio,
+			.aframe_method = global.aframe_method,
 			.redirect_exit = args->redirect_exit,
 			.devicehint_cp = args->devicehint_cp,
 			.bcache_dir = get_bcache_dir()
@@ -500,6 +506,8 @@ static void dir_a12srv(struct a12_state* S, int fd, void* tag)
 		.vframe_block = global.backpressure,
 		.vframe_soft_block = global.backpressure_soft,
 		.eval_vcodec = vcodec_tuning,
+		.audio = global.audio,
+		.aframe_method = global.aframe_method,
 		.bcache_dir = get_bcache_dir()
 	});
 	shmifsrv_free(ds->shmif, SHMIFSRV_FREE_NO_DMS);
@@ -950,6 +958,8 @@ static bool show_usage(const char* msg, char** argv, size_t i)
 #endif
 	"\tA12_VBP        \t backpressure maximium cap (0..8)\n"
 	"\tA12_VBP_SOFT   \t backpressure soft (full-frames) cap (< VBP)\n"
+	"\tA12_AUDIO      \t forward client audio (off, raw, adpcm)\n"
+	"\tA12_ZSTD_THREADS\t compression worker threads for large video frames\n"
 	"\tA12_CACHE_DIR  \t Used for caching binary stores (fonts, ...)\n\n"
 	"\tLocal Discovery mode (ignores connection arguments):\n"
 	"\tarcan-net discover passive [ff00::/8 eg. ff00::1:6]\n"
@@ -1375,6 +1385,21 @@ static int apply_commandline(int argc, char** argv, struct arcan_net_meta* meta)
 			global.backpressure_soft = bp;
 	}
 
+	if ((tmp = getenv("A12_AUDIO"))){
+		if (strcmp(tmp, "raw") == 0){
+			global.audio = true;
+			global.aframe_method = AFRAME_METHOD_RAW;
+		}
+		else if (strcmp(tmp, "adpcm") == 0){
+			global.audio = true;
+			global.aframe_method = AFRAME_METHOD_ADPCM;
+		}
+		else if (strcmp(tmp, "off") == 0)
+			global.audio = false;
+		else
+			return show_usage("A12_AUDIO: expected off, raw or adpcm", argv, i);
+	}
+
 	return i;
 }
 
@@ -1667,6 +1692,10 @@ int main(int argc, char** argv)
 	global.meta.keystore.directory.dirfd = -1;
 	global.dirsrv.a12_cfg = global.meta.opts;
 
+	const char* zthreads = getenv("A12_ZSTD_THREADS");
+	if (zthreads)
+		global.meta.opts->compression_threads = strtoul(zthreads, NULL, 10);
+
 /* set this as default, so the remote side can't actually close */
 	global.meta.redirect_exit = getenv("ARCAN_CONNPATH");
 	global.meta.devicehint_cp = getenv("ARCAN_CONNPATH");
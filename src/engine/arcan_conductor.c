@@ -81,12 +81,98 @@ static struct {
 	double transfer_cost;
 	uint8_t timestep;
 	bool in_frame;
+
+/* clients left waiting by the last staggered release, and in total */
+	size_t herd_pending;
+	size_t herd_deferred;
 } conductor = {
 	.render_cost = 4,
 	.transfer_cost = 1,
 	.timestep = 2
 };
 
+/*
+ * Cost tracking for the predictive strategy. Each phase of producing a frame
+ * gets a histogram of linear buckets and the predicted cost is the sum of the
+ * per-phase percentiles. The histograms are aged by halving once the window
+ * fills so that a change in load shows up within a few seconds while single
+ * spikes still push the upper percentiles.
+ */
+#ifndef PREDICT_PERCENTILE
+#define PREDICT_PERCENTILE 95
+#endif
+
+#define PHASE_BUCKETS 128
+#define PHASE_BUCKET_US 250
+#define PHASE_WINDOW 512
+
+enum cost_phase {
+	PHASE_PREFRAME = 0,
+	PHASE_RENDER,
+	PHASE_SYNCH,
+	PHASE_COUNT
+};
+
+static struct {
+	struct {
+		uint32_t bucket[PHASE_BUCKETS];
+		uint32_t count;
+	} phase[PHASE_COUNT];
+
+/* accumulated since the last frame */
+	uint64_t wait_us;
+
+/* elapsed / deadline (ms) relative to the last synch when we woke up */
+	int64_t wake;
+	int64_t next;
+
+	size_t hits;
+	size_t misses;
+} predict;
+
+/*
+ * Per display timeline, populated through register_display and driven by the
+ * platform through display_submit / display_synch. A display that has never
+ * synched is treated as not providing feedback and clients mapped to it stay
+ * on the global timeline.
+ */
+#ifndef CONDUCTOR_MAX_DISPLAYS
+#define CONDUCTOR_MAX_DISPLAYS 16
+#endif
+
+struct display_timeline {
+	bool used;
+	bool pending;
+	bool synched;
+	size_t gpu_id;
+	size_t disp_id;
+	float rate;
+	arcan_vobj_id obj;
+	uint64_t msc;
+	uint64_t last_synch;
+	uint64_t last_submit;
+};
+
+static struct display_timeline timelines[CONDUCTOR_MAX_DISPLAYS];
+
+/*
+ * Staggered herd release, see release_herd. Delays are in ms.
+ */
+#ifndef HERD_BURST
+#define HERD_BURST 8
+#endif
+
+#ifndef HERD_INVISIBLE_MS
+#define HERD_INVISIBLE_MS 100
+#endif
+
+enum herd_prio {
+	HERD_INVISIBLE = 0,
+	HERD_NORMAL,
+	HERD_DISPLAY,
+	HERD_FOCUS
+};
+
 static ssize_t find_frameserver(struct arcan_frameserver* fsrv);
 
 /*
@@ -104,6 +190,7 @@ static char* synchopts[] = {
 	"powersave", "synch to clock tick (~25Hz)",
 	"adaptive", "defer composition",
 	"tight", "defer composition, delay client-wake",
+	"predictive", "defer composition to the latest safe point from cost history",
 	NULL
 };
 
@@ -126,7 +213,9 @@ enum synchopts {
 /* defer composition, wake clients after vsynch */
 	SYNCH_ADAPTIVE,
 /* defer composition, wake clients after half-time */
-	SYNCH_TIGHT
+	SYNCH_TIGHT,
+/* defer composition based on percentile cost, wake clients after vsynch */
+	SYNCH_PREDICTIVE
 };
 
 static int synchopt = SYNCH_IMMEDIATE;
@@ -136,14 +225,207 @@ static int synchopt = SYNCH_IMMEDIATE;
  * where transfers might occur, unlock simply awakes clients that did
  * contribute a frame last pass but has been locked since
  */
-static void unlock_herd()
+static void release_herd(bool bound, bool drain);
+static void unlock_herd(bool force)
 {
+	if (!force){
+		release_herd(true, false);
+		return;
+	}
+
 	for (size_t i = 0; i < frameservers.count; i++)
 		if (frameservers.ref[i]){
 			TRACE_MARK_ONESHOT("conductor", "synchronization",
 				TRACE_SYS_DEFAULT, frameservers.ref[i]->vid, 0, "unlock-herd");
 			arcan_frameserver_releaselock(frameservers.ref[i]);
 		}
+
+	conductor.herd_pending = 0;
+}
+
+static struct display_timeline* find_timeline(
+	size_t gpu_id, size_t disp_id, bool alloc)
+{
+	struct display_timeline* free_slot = NULL;
+
+	for (size_t i = 0; i < CONDUCTOR_MAX_DISPLAYS; i++){
+		if (!timelines[i].used){
+			if (!free_slot)
+				free_slot = &timelines[i];
+			continue;
+		}
+		if (timelines[i].gpu_id == gpu_id && timelines[i].disp_id == disp_id)
+			return &timelines[i];
+	}
+
+	if (!alloc || !free_slot)
+		return NULL;
+
+	*free_slot = (struct display_timeline){
+		.used = true,
+		.gpu_id = gpu_id,
+		.disp_id = disp_id
+	};
+	return free_slot;
+}
+
+/*
+ * Resolve which display timeline that a frameserver follows. It is mapped to
+ * a display if it is the display source itself or attached to the rendertarget
+ * that is, and with several candidates the one with the highest rate wins.
+ */
+static struct display_timeline* fsrv_timeline(struct arcan_frameserver* fsrv)
+{
+	struct arcan_vobject* vobj = arcan_video_getobject(fsrv->vid);
+	struct display_timeline* res = NULL;
+	if (!vobj)
+		return NULL;
+
+	for (size_t i = 0; i < CONDUCTOR_MAX_DISPLAYS; i++){
+		struct display_timeline* tl = &timelines[i];
+		if (!tl->used || !tl->synched)
+			continue;
+
+		bool match = tl->obj == fsrv->vid;
+		if (!match && vobj->owner){
+			struct arcan_vobject* src = arcan_video_getobject(tl->obj);
+			match = src && vobj->owner->color == src;
+		}
+
+		if (match && (!res || tl->rate > res->rate))
+			res = tl;
+	}
+
+	return res;
+}
+
+/* the display timeline that is expected to scan out next */
+static struct display_timeline* next_timeline()
+{
+	struct display_timeline* res = NULL;
+	uint64_t best = 0;
+
+	for (size_t i = 0; i < CONDUCTOR_MAX_DISPLAYS; i++){
+		struct display_timeline* tl = &timelines[i];
+		if (!tl->used || !tl->synched)
+			continue;
+
+		uint64_t next = tl->last_synch +
+			(uint64_t)(1000.0f / (tl->rate > 0 ? tl->rate : 60.0f));
+		if (!res || next < best){
+			res = tl;
+			best = next;
+		}
+	}
+
+	return res;
+}
+
+static enum herd_prio herd_priority(
+	struct arcan_frameserver* fsrv, struct display_timeline* next)
+{
+	if (fsrv == frameservers.focus)
+		return HERD_FOCUS;
+
+	struct arcan_vobject* vobj = arcan_video_getobject(fsrv->vid);
+	if (!vobj)
+		return HERD_INVISIBLE;
+
+/* a common pattern is to keep the frameserver vid hidden and share its store
+ * into the surfaces that are actually drawn, those can't be traced back from
+ * here so treat it as visible. The same goes for anything that is captured or
+ * streamed through a readback, opacity or not. */
+	if ((!vobj->vstore || vobj->vstore->refcount <= 1) &&
+		!arcan_vint_readback_source(vobj)){
+		surface_properties prop;
+		arcan_resolve_vidprop(vobj, 0.0, &prop);
+		if (!vobj->extrefc.lists || prop.opa < EPSILON)
+			return HERD_INVISIBLE;
+	}
+
+	if (next && fsrv_timeline(fsrv) == next)
+		return HERD_DISPLAY;
+
+	return HERD_NORMAL;
+}
+
+/*
+ * Release the clients that are waiting on the conductor, but staggered so
+ * that they don't all wake up and signal in the same burst right before
+ * composition. The focus target and clients on the display that is next to
+ * scan out go first, other visible ones in batches of HERD_BURST with the rest
+ * picked up by drain_herd during the synch wait (and at the latest on the next
+ * release), and invisible ones are throttled to one release per
+ * HERD_INVISIBLE_MS.
+ *
+ * [bound] also includes clients paced by a display timeline of their own,
+ * those are otherwise released in display_synch.
+ */
+static void release_herd(bool bound, bool drain)
+{
+	struct display_timeline* next = next_timeline();
+	uint64_t now = arcan_timemillis();
+	size_t budget = HERD_BURST;
+	size_t deferred = 0;
+
+	for (size_t i = 0; i < frameservers.count; i++){
+		struct arcan_frameserver* fsrv = frameservers.ref[i];
+		if (!fsrv || !fsrv->flags.release_pending)
+			continue;
+
+		if (!bound && fsrv_timeline(fsrv))
+			continue;
+
+/* draining only covers those that were deferred, anything that became ready
+ * after the release pass waits for the next one like before */
+		if (drain && !fsrv->flags.herd_deferred)
+			continue;
+
+		uint64_t waited = now > fsrv->last_release ? now - fsrv->last_release : 0;
+		bool release = false;
+
+		switch (herd_priority(fsrv, next)){
+		case HERD_FOCUS:
+		case HERD_DISPLAY:
+			release = true;
+		break;
+		case HERD_NORMAL:
+			release = budget > 0 || (!drain && fsrv->flags.herd_deferred);
+		break;
+		case HERD_INVISIBLE:
+			release = waited >= HERD_INVISIBLE_MS;
+		break;
+		}
+
+		if (!release){
+			fsrv->flags.herd_deferred = true;
+			deferred++;
+			continue;
+		}
+
+		if (budget)
+			budget--;
+
+		fsrv->flags.herd_deferred = false;
+
+		TRACE_MARK_ONESHOT("conductor", "synchronization",
+			TRACE_SYS_DEFAULT, fsrv->vid, waited, "unlock-herd");
+		arcan_frameserver_releaselock(fsrv);
+	}
+
+	conductor.herd_pending = deferred;
+	if (deferred && !drain){
+		conductor.herd_deferred += deferred;
+		TRACE_MARK_ONESHOT("conductor", "synchronization",
+			TRACE_SYS_DEFAULT, deferred, conductor.herd_deferred, "herd-deferred");
+	}
+}
+
+/* continue a staggered release while waiting for the displays */
+static void drain_herd()
+{
+	if (conductor.herd_pending)
+		release_herd(true, true);
 }
 
 static void step_herd(int mode)
@@ -170,7 +452,7 @@ static void forward_vblank()
 {
 	for (size_t i = 0; i < frameservers.count; i++){
 		struct arcan_frameserver* fsrv = frameservers.ref[i];
-		if (fsrv && fsrv->clock.vblank){
+		if (fsrv && fsrv->clock.vblank && !fsrv_timeline(fsrv)){
 			struct arcan_vobject* vobj = arcan_video_getobject(fsrv->vid);
 
 			platform_fsrv_pushevent(fsrv, &(struct arcan_event){
@@ -184,6 +466,15 @@ static void forward_vblank()
 	}
 }
 
+/* the displays have all synched, anything uploaded is now on its way out */
+static void present_herd()
+{
+	unsigned long long ts = arcan_timemicros();
+	for (size_t i = 0; i < frameservers.count; i++)
+		if (frameservers.ref[i])
+			arcan_frameserver_pacing_present(frameservers.ref[i], ts);
+}
+
 static void internal_yield()
 {
 	arcan_event_poll_sources(arcan_event_defaultctx(), conductor.timestep);
@@ -238,6 +529,17 @@ void arcan_conductor_register_display(size_t gpu_id,
 	char buf[48];
 	snprintf(buf, 48, "register:%zu:%zu:%zu", gpu_id, disp_id, (size_t) obj);
 	TRACE_MARK_ONESHOT("conductor", "display", TRACE_SYS_DEFAULT, gpu_id, 0, buf);
+
+/* re-registering (remap, mode change) keeps the synch state */
+	struct display_timeline* tl = find_timeline(gpu_id, disp_id, true);
+	if (!tl){
+		TRACE_MARK_ONESHOT("conductor", "display",
+			TRACE_SYS_WARN, gpu_id, disp_id, "timeline-full");
+		return;
+	}
+
+	tl->rate = rate;
+	tl->obj = obj;
 }
 
 void arcan_conductor_release_display(size_t gpu_id, size_t disp_id)
@@ -246,6 +548,95 @@ void arcan_conductor_release_display(size_t gpu_id, size_t disp_id)
 	char buf[24];
 	snprintf(buf, 24, "release:%zu:%zu", gpu_id, disp_id);
 	TRACE_MARK_ONESHOT("conductor", "display", TRACE_SYS_DEFAULT, gpu_id, 0, buf);
+
+	struct display_timeline* tl = find_timeline(gpu_id, disp_id, false);
+	if (tl)
+		*tl = (struct display_timeline){0};
+}
+
+void arcan_conductor_display_submit(size_t gpu_id, size_t disp_id)
+{
+	struct display_timeline* tl = find_timeline(gpu_id, disp_id, false);
+	if (tl){
+		tl->pending = true;
+		tl->last_submit = arcan_timemillis();
+	}
+}
+
+void arcan_conductor_display_cancel(size_t gpu_id, size_t disp_id)
+{
+	struct display_timeline* tl = find_timeline(gpu_id, disp_id, false);
+	if (tl)
+		tl->pending = false;
+}
+
+void arcan_conductor_display_synch(size_t gpu_id, size_t disp_id, uint64_t msc)
+{
+	struct display_timeline* tl = find_timeline(gpu_id, disp_id, false);
+	if (!tl)
+		return;
+
+	tl->pending = false;
+	tl->synched = true;
+	tl->msc = msc;
+	tl->last_synch = arcan_timemillis();
+
+	TRACE_MARK_ONESHOT("conductor", "display",
+		TRACE_SYS_FAST, disp_id, msc, "display-synch");
+
+/* the strategies that release clients after vsynch do so on the timeline of
+ * the display they are mapped to, the others release on buffer ack anyway */
+	bool release =
+		synchopt == SYNCH_VSYNCH || synchopt == SYNCH_ADAPTIVE ||
+		synchopt == SYNCH_POWERSAVE || synchopt == SYNCH_PREDICTIVE;
+
+	for (size_t i = 0; i < frameservers.count; i++){
+		struct arcan_frameserver* fsrv = frameservers.ref[i];
+		if (!fsrv || fsrv_timeline(fsrv) != tl)
+			continue;
+
+		if (release)
+			arcan_frameserver_releaselock(fsrv);
+
+		if (fsrv->clock.vblank){
+			platform_fsrv_pushevent(fsrv, &(struct arcan_event){
+				.category = EVENT_TARGET,
+				.tgt.kind = TARGET_COMMAND_STEPFRAME,
+				.tgt.ioevs[0].iv = 0,
+				.tgt.ioevs[1].iv = 2,
+				.tgt.ioevs[2].uiv = msc
+			});
+		}
+	}
+}
+
+bool arcan_conductor_display_busy(arcan_vobj_id vid)
+{
+	bool found = false;
+	uint64_t now = arcan_timemillis();
+
+	for (size_t i = 0; i < CONDUCTOR_MAX_DISPLAYS; i++){
+		struct display_timeline* tl = &timelines[i];
+		if (!tl->used || !tl->synched || tl->obj != vid)
+			continue;
+
+		if (!tl->pending)
+			return false;
+
+/* a completion that hasn't arrived within two periods is not going to, the
+ * platform might have lost the event or the display, don't defer on that */
+		uint64_t period = tl->rate > 0 ? 1000.0 / tl->rate : 16;
+		if (now - tl->last_submit > 2 * period){
+			TRACE_MARK_ONESHOT("conductor", "display",
+				TRACE_SYS_WARN, tl->disp_id, now - tl->last_submit, "synch-timeout");
+			tl->pending = false;
+			return false;
+		}
+
+		found = true;
+	}
+
+	return found;
 }
 
 void arcan_conductor_register_frameserver(struct arcan_frameserver* fsrv)
@@ -302,6 +693,7 @@ void arcan_conductor_register_frameserver(struct arcan_frameserver* fsrv)
 int arcan_conductor_yield(struct conductor_display* disps, size_t pset_count)
 {
 	arcan_audio_refresh();
+	drain_herd();
 
 /* by returning false here we tell the platform to not even wait for synch
  * signal from screens but rather continue immediately */
@@ -319,6 +711,7 @@ int arcan_conductor_yield(struct conductor_display* disps, size_t pset_count)
 	}
 
 /* same as other timesleep calls, should be replaced with poll and pollset */
+	predict.wait_us += conductor.timestep * 1000;
 	return conductor.timestep;
 }
 
@@ -362,6 +755,7 @@ void arcan_conductor_setsynch(const char* arg)
 	case SYNCH_VSYNCH:
 	case SYNCH_ADAPTIVE:
 	case SYNCH_POWERSAVE:
+	case SYNCH_PREDICTIVE:
 		arcan_frameserver_lock_buffers(2);
 	break;
 	case SYNCH_TIGHT:
@@ -370,7 +764,7 @@ void arcan_conductor_setsynch(const char* arg)
 	case SYNCH_IMMEDIATE:
 	case SYNCH_PROCESSING:
 		arcan_frameserver_lock_buffers(0);
-		unlock_herd();
+		unlock_herd(true);
 	break;
 	}
 }
@@ -512,6 +906,59 @@ static int estimate_frame_cost()
 	return conductor.render_cost + conductor.transfer_cost + conductor.timestep;
 }
 
+static void phase_sample(enum cost_phase phase, uint64_t us)
+{
+	size_t ind = us / PHASE_BUCKET_US;
+	if (ind >= PHASE_BUCKETS)
+		ind = PHASE_BUCKETS - 1;
+
+	predict.phase[phase].bucket[ind]++;
+	predict.phase[phase].count++;
+
+	if (predict.phase[phase].count < PHASE_WINDOW)
+		return;
+
+	predict.phase[phase].count = 0;
+	for (size_t i = 0; i < PHASE_BUCKETS; i++){
+		predict.phase[phase].bucket[i] >>= 1;
+		predict.phase[phase].count += predict.phase[phase].bucket[i];
+	}
+}
+
+static uint64_t phase_percentile(enum cost_phase phase, unsigned pct)
+{
+	uint64_t lim = ((uint64_t) predict.phase[phase].count * pct + 99) / 100;
+	uint64_t acc = 0;
+
+	if (!lim)
+		return 0;
+
+/* upper edge of the bucket so that the prediction errs on the safe side */
+	for (size_t i = 0; i < PHASE_BUCKETS; i++){
+		acc += predict.phase[phase].bucket[i];
+		if (acc >= lim)
+			return (i + 1) * PHASE_BUCKET_US;
+	}
+
+	return PHASE_BUCKETS * PHASE_BUCKET_US;
+}
+
+/* ticks are processed before the wakeup check and are not sampled, only what
+ * runs between wakeup and the display synch counts */
+static int predict_frame_cost()
+{
+	uint64_t us =
+		phase_percentile(PHASE_PREFRAME, PREDICT_PERCENTILE) +
+		phase_percentile(PHASE_RENDER, PREDICT_PERCENTILE) +
+		phase_percentile(PHASE_SYNCH, PREDICT_PERCENTILE);
+
+/* no history yet, fall back to the moving average */
+	if (!us)
+		return estimate_frame_cost();
+
+	return (us + 999) / 1000 + 1;
+}
+
 static bool preframe_synch(int next, int elapsed)
 {
 	switch(synchopt){
@@ -540,7 +987,7 @@ static bool preframe_synch(int next, int elapsed)
 		else if (elapsed < next - estimate_frame_cost()){
 			if (!conductor.in_frame){
 				conductor.in_frame = true;
-				unlock_herd();
+				unlock_herd(false);
 				internal_yield();
 				return false;
 			}
@@ -552,6 +999,24 @@ static bool preframe_synch(int next, int elapsed)
 			TRACE_SYS_DEFAULT, 0, elapsed - margin, "tight-deadline");
 		return true;
 	}
+/* sleep until the latest point where the predicted cost still fits, but in
+ * steps no longer than the timestep so that event processing keeps going */
+	case SYNCH_PREDICTIVE:{
+		ssize_t margin = next - predict_frame_cost();
+		if (elapsed < margin){
+			ssize_t step = margin - elapsed;
+			arcan_event_poll_sources(arcan_event_defaultctx(),
+				step < conductor.timestep ? step : conductor.timestep);
+			return false;
+		}
+
+		predict.wake = elapsed;
+		predict.next = next;
+
+		TRACE_MARK_ONESHOT("conductor", "synchronization",
+			TRACE_SYS_DEFAULT, 0, elapsed - margin, "predictive-deadline");
+		return true;
+	}
 	case SYNCH_VSYNCH:
 	case SYNCH_PROCESSING:
 	case SYNCH_IMMEDIATE:
@@ -567,16 +1032,16 @@ static uint64_t postframe_synch(uint64_t next)
 	case SYNCH_VSYNCH:
 	case SYNCH_ADAPTIVE:
 	case SYNCH_POWERSAVE:
-		unlock_herd();
+	case SYNCH_PREDICTIVE:
+		release_herd(false, false);
 	break;
 	case SYNCH_PROCESSING:
 	case SYNCH_IMMEDIATE:
 	break;
 	}
 
-/* this is not the 'correct' time to do this for multiscreen settings, we would
- * need to let the platform expose that event per screen and bias to the one (if
- * any) the frameserver is actually mapped to the vblank on. */
+/* clients mapped to a display with its own timeline get this in display_synch,
+ * the rest follow the global synch */
 	forward_vblank();
 
 	conductor.in_frame = false;
@@ -600,13 +1065,62 @@ int arcan_conductor_reset_count(bool step)
 	return reset_counter;
 }
 
+/*
+ * Sample the phases of the frame that just finished and, if it was scheduled
+ * by the predictive strategy, check if the work between wakeup and handing
+ * over to the display would have made the deadline.
+ */
+static void update_prediction(
+	uint64_t pre_start, uint64_t synch_start, uint64_t synch_end)
+{
+	arcan_benchdata* stats = arcan_bench_data();
+	size_t nc = COUNT_OF(stats->framecost);
+	size_t ofs = (uint8_t) stats->costofs;
+
+/* the cost slot only advances when benchmarking is enabled */
+	if (stats->bench_enabled)
+		ofs = (ofs + nc - 1) % nc;
+
+	uint64_t render = (uint64_t) stats->framecost[ofs] * 1000;
+	uint64_t synch = synch_end - synch_start;
+	uint64_t overhead = synch > render + predict.wait_us ?
+		synch - render - predict.wait_us : 0;
+
+	phase_sample(PHASE_PREFRAME, synch_start - pre_start);
+	phase_sample(PHASE_RENDER, render);
+	phase_sample(PHASE_SYNCH, overhead);
+
+	if (synchopt != SYNCH_PREDICTIVE || predict.next <= 0)
+		return;
+
+	uint64_t work = (synch_start - pre_start) + render + overhead;
+	bool miss = predict.wake * 1000 + work > predict.next * 1000;
+	if (miss)
+		predict.misses++;
+	else
+		predict.hits++;
+
+	TRACE_MARK_ONESHOT("conductor", "synchronization",
+		miss ? TRACE_SYS_WARN : TRACE_SYS_DEFAULT,
+		predict.hits, predict.misses,
+		miss ? "predictive-miss" : "predictive-hit"
+	);
+
+	predict.next = 0;
+}
+
 static int trigger_video_synch(float frag)
 {
 	conductor.set_deadline = -1;
 
 	TRACE_MARK_ENTER("conductor", "platform-frame", TRACE_SYS_DEFAULT, conductor.tick_count, frag, "");
+		uint64_t pre_start = arcan_timemicros();
 		arcan_lua_callvoidfun(main_lua_context, "preframe_pulse", false, NULL);
+		uint64_t synch_start = arcan_timemicros();
+			predict.wait_us = 0;
 			platform_video_synch(conductor.tick_count, frag, NULL, NULL);
+			uint64_t synch_end = arcan_timemicros();
+			present_herd();
 
 			#ifdef WITH_TRACY
 			TracyCFrameMark
@@ -622,6 +1136,8 @@ static int trigger_video_synch(float frag)
 		0.8 * (double)stats->framecost[(uint8_t)stats->costofs] +
 		0.2 * conductor.render_cost;
 
+	update_prediction(pre_start, synch_start, synch_end);
+
 	TRACE_MARK_ONESHOT("conductor", "frame-over", TRACE_SYS_DEFAULT, 0, conductor.set_deadline, "");
 
 	valid_cycle = true;
@@ -710,7 +1226,7 @@ int arcan_conductor_run(arcan_tick_cb tick)
  * indefinitely */
 			if (synchopt == SYNCH_TIGHT && !conductor.in_frame){
 				conductor.in_frame = true;
-				unlock_herd();
+				unlock_herd(false);
 			}
 
 			next_synch = postframe_synch( trigger_video_synch(frag) );
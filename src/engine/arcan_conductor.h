@@ -40,6 +40,31 @@ void arcan_conductor_register_display(size_t gpu_id,
  * Release a previously registered display and gpu pairing */
 void arcan_conductor_release_display(size_t gpu_id, size_t disp_id);
 
+/* [ called from platform ]
+ * A frame has been queued for the display and it won't accept another one
+ * until the platform signals completion through display_synch. */
+void arcan_conductor_display_submit(size_t gpu_id, size_t disp_id);
+
+/* [ called from platform ]
+ * A submitted frame will not complete (failed flip, display disabled), stop
+ * treating the display as busy. */
+void arcan_conductor_display_cancel(size_t gpu_id, size_t disp_id);
+
+/* [ called from platform ]
+ * The display has finished presenting the last submitted frame at [msc].
+ * Once a display has signalled this, frameservers mapped to it get their
+ * vblank forwarding and buffer release on this timeline instead of the
+ * global one, letting displays with different refresh rates run at their
+ * own pace. */
+void arcan_conductor_display_synch(size_t gpu_id, size_t disp_id, uint64_t msc);
+
+/* [ called from video ]
+ * Returns true if [vid] is mapped to one or more displays and all of them
+ * are still busy with a previous frame, meaning that updating the contents
+ * now would only be discarded. A display that hasn't completed within two
+ * of its refresh periods is no longer considered busy. */
+bool arcan_conductor_display_busy(arcan_vobj_id vid);
+
 /* [ called from platform ]
  * mark GPU as locked and add [fence] to pollset, when there's data on fence,
  * invoke the lockhandler callback which [may] release the gpu.
@@ -23,6 +23,8 @@
 #include <math.h>
 #include <assert.h>
 #include <signal.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 /*
  * fixed limit of allowed events in queue before we need to do something more
@@ -33,6 +35,21 @@
 #define ARCAN_EVENT_QUEUE_LIM 255
 #endif
 
+/*
+ * number of slots in the queue used by threads other than the main one when
+ * enqueueing into the default context, needs to be a power of two
+ */
+#ifndef ARCAN_EVENT_MPSC_LIM
+#define ARCAN_EVENT_MPSC_LIM 256
+#endif
+
+/*
+ * number of events moved out of the queues at a time in _feed
+ */
+#ifndef ARCAN_EVENT_FEED_BATCH
+#define ARCAN_EVENT_FEED_BATCH 32
+#endif
+
 #include "arcan_math.h"
 #include "arcan_general.h"
 #include "arcan_video.h"
@@ -51,6 +68,9 @@ static arcan_event eventbuf[ARCAN_EVENT_QUEUE_LIM];
 static uint8_t eventfront = 0, eventback = 0;
 static int64_t epoch;
 
+/* bumped on purge so that _feed can drop what it already moved out */
+static uint64_t purge_gen;
+
 /* basic context is just mapped on the static buffer, the reason for this
  * construct is to share code with the event ring buffers in shmif */
 static struct arcan_evctx default_evctx = {
@@ -83,6 +103,103 @@ static struct pollfd evsrc_pollset[64];
 static struct evsrc_meta evsrc_meta[64];
 static uint64_t evsrc_bitmap;
 
+/*
+ * Bounded lock-free multi-producer, single-consumer queue for the default
+ * context. The main ring above is only safe to touch from the thread that
+ * runs _feed, so enqueue from any other thread (input drivers, loaders,
+ * helper threads) gets redirected here. Each cell carries a sequence number
+ * that tells producers if it is free for their ticket and the consumer if it
+ * has been filled, so producers only contend on the tail counter. Both _feed
+ * and _poll drain it before the main ring.
+ *
+ * The asynch image loaders use it to signal completion, other worker threads
+ * (tick interpolation, screenshot writers) have no results to post.
+ */
+struct mpsc_cell {
+	_Atomic size_t seq;
+	arcan_event ev;
+};
+
+static struct {
+	struct mpsc_cell cells[ARCAN_EVENT_MPSC_LIM];
+	_Atomic size_t tail;
+	size_t head;
+	pthread_once_t init;
+	pthread_t owner;
+	bool owner_set;
+} mpsc = {
+	.init = PTHREAD_ONCE_INIT
+};
+
+static void mpsc_setup()
+{
+	for (size_t i = 0; i < ARCAN_EVENT_MPSC_LIM; i++)
+		atomic_store_explicit(&mpsc.cells[i].seq, i, memory_order_relaxed);
+	atomic_store_explicit(&mpsc.tail, 0, memory_order_release);
+}
+
+static bool mpsc_foreign()
+{
+	return mpsc.owner_set && !pthread_equal(pthread_self(), mpsc.owner);
+}
+
+static bool mpsc_enqueue(const struct arcan_event* const src)
+{
+	pthread_once(&mpsc.init, mpsc_setup);
+
+	size_t pos = atomic_load_explicit(&mpsc.tail, memory_order_relaxed);
+	struct mpsc_cell* cell;
+
+	for(;;){
+		cell = &mpsc.cells[pos & (ARCAN_EVENT_MPSC_LIM - 1)];
+		size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+		intptr_t dif = (intptr_t) seq - (intptr_t) pos;
+
+/* free for our ticket, try to claim it */
+		if (dif == 0){
+			if (atomic_compare_exchange_weak_explicit(&mpsc.tail,
+				&pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+				break;
+		}
+/* consumer hasn't caught up with this lap yet */
+		else if (dif < 0)
+			return false;
+		else
+			pos = atomic_load_explicit(&mpsc.tail, memory_order_relaxed);
+	}
+
+	cell->ev = *src;
+	atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+	return true;
+}
+
+/* consumer side, only ever called from the owner thread */
+static size_t mpsc_dequeue(arcan_event* dst, size_t lim)
+{
+	pthread_once(&mpsc.init, mpsc_setup);
+
+	size_t n = 0;
+	while (n < lim){
+		struct mpsc_cell* cell = &mpsc.cells[mpsc.head & (ARCAN_EVENT_MPSC_LIM - 1)];
+		size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+		if (seq != mpsc.head + 1)
+			break;
+
+		dst[n++] = cell->ev;
+		atomic_store_explicit(&cell->seq,
+			mpsc.head + ARCAN_EVENT_MPSC_LIM, memory_order_release);
+		mpsc.head++;
+	}
+
+	return n;
+}
+
+static void mpsc_flush()
+{
+	arcan_event ev;
+	while (mpsc_dequeue(&ev, 1)){}
+}
+
 arcan_evctx* arcan_event_defaultctx(){
 	return &default_evctx;
 }
@@ -114,6 +231,11 @@ static bool queue_empty(arcan_evctx* ctx)
 int arcan_event_poll(arcan_evctx* ctx, struct arcan_event* dst)
 {
 	assert(dst);
+
+/* same order as _feed, events from other threads have waited the longest */
+	if (ctx == &default_evctx && mpsc_dequeue(dst, 1))
+		return 1;
+
 	if (queue_empty(ctx))
 		return 0;
 
@@ -199,6 +321,12 @@ int arcan_event_enqueue(arcan_evctx* ctx, const struct arcan_event* const src)
 		|| (ctx->state_fl & EVSTATE_DEAD) > 0)
 		return ARCAN_OK;
 
+/* from another thread, the ring and the drain belong to the main thread so
+ * take the lock-free path and never block, the caller gets to retry or drop */
+	if (ctx == &default_evctx && mpsc_foreign()){
+		return mpsc_enqueue(src) ? ARCAN_OK : ARCAN_ERRC_OUT_OF_SPACE;
+	}
+
 /* One big caveat with this approach is the possibility of feedback loop with
  * magnification - forcing us to break ordering by directly feeding drain.
  * Given that we have special treatment for _EXPIRE and similar calls,
@@ -601,8 +729,10 @@ void arcan_bench_register_tick(unsigned nticks)
 
 void arcan_event_purge()
 {
+	purge_gen++;
 	eventfront = 0;
 	eventback = 0;
+	mpsc_flush();
 	platform_event_reset(&default_evctx);
 }
 
@@ -650,6 +780,7 @@ void arcan_event_deinit(arcan_evctx* ctx, bool flush)
 		return;
 
 	eventfront = eventback = 0;
+	mpsc_flush();
 }
 
 #ifdef _DEBUG
@@ -679,6 +810,32 @@ static void sig_rtfuzz_b(int v)
 }
 #endif
 
+static void feed_event(struct arcan_evctx* ctx,
+	arcan_event* ev, arcan_event_handler hnd, int* exit_code)
+{
+	switch (ev->category){
+		case EVENT_VIDEO:
+			if (ev->vid.kind == EVENT_VIDEO_EXPIRE)
+				arcan_video_deleteobject(ev->vid.source);
+			else if (ev->vid.kind == EVENT_VIDEO_ASYNCHIMAGE_READY)
+				arcan_video_joinasynch(ev->vid.source);
+			else
+				hnd(ev, 0);
+		break;
+
+		case EVENT_SYSTEM:
+			if (ev->sys.kind == EVENT_SYSTEM_EXIT){
+				ctx->state_fl |= EVSTATE_DEAD;
+				ctx->exit_code = ev->sys.errcode;
+				if (exit_code) *exit_code = ev->sys.errcode;
+				break;
+			}
+		default:
+			hnd(ev, 0);
+		break;
+	}
+}
+
 bool arcan_event_feed(struct arcan_evctx* ctx,
 	arcan_event_handler hnd, int* exit_code)
 {
@@ -689,30 +846,28 @@ bool arcan_event_feed(struct arcan_evctx* ctx,
 		return false;
 	}
 
-	while (*ctx->front != *ctx->back){
-/* slide, we forego _poll to cut down on one copy */
-		arcan_event* ev = &ctx->eventbuf[ *(ctx->front) ];
-		*(ctx->front) = (*(ctx->front) + 1) % ctx->eventbuf_sz;
-
-		switch (ev->category){
-			case EVENT_VIDEO:
-				if (ev->vid.kind == EVENT_VIDEO_EXPIRE)
-					arcan_video_deleteobject(ev->vid.source);
-				else
-					hnd(ev, 0);
-			break;
+/* Move events out in batches so the ring slots are released before the
+ * handler gets to run (and possibly enqueue more), events from other threads
+ * go first as they have been waiting since the last feed. */
+	arcan_event batch[ARCAN_EVENT_FEED_BATCH];
+	for(;;){
+		size_t n = 0;
+		if (ctx == &default_evctx)
+			n = mpsc_dequeue(batch, ARCAN_EVENT_FEED_BATCH);
+
+		while (n < ARCAN_EVENT_FEED_BATCH && *ctx->front != *ctx->back){
+			batch[n++] = ctx->eventbuf[ *(ctx->front) ];
+			*(ctx->front) = (*(ctx->front) + 1) % ctx->eventbuf_sz;
+		}
 
-			case EVENT_SYSTEM:
-				if (ev->sys.kind == EVENT_SYSTEM_EXIT){
-					ctx->state_fl |= EVSTATE_DEAD;
-					ctx->exit_code = ev->sys.errcode;
-					if (exit_code) *exit_code = ev->sys.errcode;
-					break;
-				}
-			default:
-				hnd(ev, 0);
+		if (!n)
 			break;
-		}
+
+/* a handler that purges (collapse, adopt) invalidates the rest of the batch,
+ * vids and tags in there refer to the state that was just reset */
+		uint64_t gen = purge_gen;
+		for (size_t i = 0; i < n && gen == purge_gen; i++)
+			feed_event(ctx, &batch[i], hnd, exit_code);
 	}
 
 	if (ctx->state_fl & EVSTATE_DEAD)
@@ -858,6 +1013,14 @@ void arcan_event_init(arcan_evctx* ctx)
 				"expecting number:number (keysym:modifiers).\n", panicbutton);
 	}
 
+/* whoever initializes the default context is the one that feeds it, other
+ * threads get their events routed through the mpsc queue */
+	if (ctx == &default_evctx && !mpsc.owner_set){
+		pthread_once(&mpsc.init, mpsc_setup);
+		mpsc.owner = pthread_self();
+		mpsc.owner_set = true;
+	}
+
 	epoch = arcan_timemillis() - ctx->c_ticks * ARCAN_TIMER_TICK;
 	platform_event_init(ctx);
 }
@@ -76,7 +76,8 @@ void arcan_event_poll_sources(struct arcan_evctx* ctx, int timeout);
 /*
  * Process the entire event queue and forward relevant events through [hnd].
  * Will return false if an exit state is enqueued, and optional [ec] exit code
- * set.
+ * set. Events are moved out of the queue in batches before being forwarded,
+ * for the default context, events enqueued from other threads come first.
  */
 bool arcan_event_feed(struct arcan_evctx*, arcan_event_handler hnd, int* ec);
 
@@ -110,6 +111,11 @@ int arcan_event_queuetransfer(
  * enqueue event into context, returns [ARCAN_OK] if successful or
  * [ARCAN_ERRC_OUT_SPACE]  if the context lacks a drain function and the queue
  * is full.
+ *
+ * For the default context this is safe to call from any thread. Events from
+ * threads other than the one that initialized the context go through a
+ * lock-free queue that is merged in on the next _feed, these never reach the
+ * drain function and fail with [ARCAN_ERRC_OUT_SPACE] rather than block.
  */
 int arcan_event_enqueue(struct arcan_evctx*, const struct arcan_event* const);
 
@@ -61,6 +61,38 @@ static inline void emit_deliveredframe(arcan_frameserver* src,
 static inline void emit_droppedframe(arcan_frameserver* src,
 	unsigned long long pts, unsigned long long framecount);
 
+static void pacing_sample(struct arcan_fsrv_histogram* dst, uint64_t us)
+{
+	size_t ind = 0;
+	for (uint64_t v = us >> 8; v && ind < FSRV_PACING_BUCKETS - 1; v >>= 1)
+		ind++;
+
+	dst->bucket[ind]++;
+	dst->sum += us;
+	dst->count++;
+	if (us > dst->max)
+		dst->max = us > UINT32_MAX ? UINT32_MAX : us;
+}
+
+void arcan_frameserver_pacing_present(
+	struct arcan_frameserver* tgt, unsigned long long ts)
+{
+	struct arcan_fsrv_pacing* pc = &tgt->desc.pacing;
+	if (!pc->pending_ts)
+		return;
+
+	pacing_sample(&pc->latency, ts > pc->pending_ts ? ts - pc->pending_ts : 0);
+	pc->pending_ts = 0;
+}
+
+void arcan_frameserver_pacing_reset(struct arcan_frameserver* tgt)
+{
+	bool audio_seen = tgt->desc.pacing.audio_seen;
+	tgt->desc.pacing = (struct arcan_fsrv_pacing){
+		.audio_seen = audio_seen
+	};
+}
+
 static void autoclock_frame(arcan_frameserver* tgt)
 {
 	if (!tgt->clock.left)
@@ -760,6 +792,7 @@ int arcan_frameserver_releaselock(struct arcan_frameserver* tgt)
 	}
 
 	tgt->flags.release_pending = false;
+	tgt->last_release = arcan_timemillis();
 	TRAMP_GUARD(0, tgt);
 
 	atomic_store_explicit(&tgt->shm.ptr->vready, 0, memory_order_release);
@@ -835,6 +868,10 @@ enum arcan_ffunc_rv arcan_frameserver_vdirect FFUNC_HEAD
  * initiated or not */
 		rv = (tgt->shm.ptr->vready &&
 			!tgt->flags.release_pending) ? FRV_GOTFRAME : FRV_NOFRAME;
+
+/* first time we see the frame as ready is the start of its queue latency */
+		if (rv == FRV_GOTFRAME && !tgt->desc.pacing.ready_ts)
+			tgt->desc.pacing.ready_ts = arcan_timemicros();
 	break;
 
 	case FFUNC_TICK:
@@ -884,12 +921,27 @@ enum arcan_ffunc_rv arcan_frameserver_vdirect FFUNC_HEAD
 		if (g_buffers_locked == 1 || tgt->flags.locked)
 			goto no_out;
 
+		uint64_t upload_start = arcan_timemicros();
 		int buffer_status = push_buffer(tgt,
 			dst_store, shmpage->hints & SHMIF_RHINT_SUBREGION ? &dirty : NULL);
 
 		if (-1 == buffer_status)
 			goto no_out;
 
+/* a frame that was uploaded but replaced before any display synch consumed it
+ * was never seen, count that as dropped */
+		struct arcan_fsrv_pacing* pc = &tgt->desc.pacing;
+		uint64_t upload_end = arcan_timemicros();
+		pacing_sample(&pc->upload, upload_end - upload_start);
+		if (pc->last_upload)
+			pacing_sample(&pc->interval, upload_start - pc->last_upload);
+		if (pc->pending_ts)
+			pc->dropped++;
+
+		pc->last_upload = upload_start;
+		pc->pending_ts = pc->ready_ts ? pc->ready_ts : upload_start;
+		pc->ready_ts = 0;
+
 /* TIMING/PRESENT:
  *     for tighter latency management, here is where the estimated next synch
  *     deadline for any output it is used on could/should be set, though it
@@ -1100,10 +1152,49 @@ enum arcan_ffunc_rv arcan_frameserver_avfeedframe FFUNC_HEAD
  * encode in the target framerate, it is up to the frameserver to determine
  * when to drop and when to double frames
  */
-			struct arcan_shmif_region reg;
-			if (src->desc.region_valid)
-				reg = src->desc.region;
-			else
+			struct arcan_shmif_region reg = {
+				.x2 = src->desc.width, .y2 = src->desc.height
+			};
+
+/* the readback only refreshes the part of [buf] that was damaged since the
+ * last one, the rest is already present in the segment buffer. That only
+ * holds if the readback matches the segment, a resize in flight means a full
+ * copy of what fits and a full readback the next time around */
+			struct rendertarget* rtgt = NULL;
+			arcan_vobject* rvobj = arcan_video_getobject(src->vid);
+			if (rvobj)
+				rtgt = arcan_vint_findrt(rvobj);
+
+			bool full = width != src->desc.width || height != src->desc.height;
+			if (full && rtgt)
+				rtgt->readback_full = true;
+
+			if (cmd == FFUNC_READBACK && !full && rtgt){
+				struct agp_region* rr = &rtgt->readback_region;
+				if (rr->x2 > rr->x1 && rr->y2 > rr->y1 &&
+					rr->x2 <= width && rr->y2 <= height){
+					reg = (struct arcan_shmif_region){
+						.x1 = rr->x1, .y1 = rr->y1, .x2 = rr->x2, .y2 = rr->y2
+					};
+				}
+			}
+
+/* an explicitly set region from the scripting layer adds to the damage */
+			if (src->desc.region_valid && !full){
+				reg.x1 = src->desc.region.x1 < reg.x1 ? src->desc.region.x1 : reg.x1;
+				reg.y1 = src->desc.region.y1 < reg.y1 ? src->desc.region.y1 : reg.y1;
+				reg.x2 = src->desc.region.x2 > reg.x2 ? src->desc.region.x2 : reg.x2;
+				reg.y2 = src->desc.region.y2 > reg.y2 ? src->desc.region.y2 : reg.y2;
+
+				if (reg.x2 > width)
+					reg.x2 = width;
+				if (reg.y2 > height)
+					reg.y2 = height;
+				if (reg.x1 >= reg.x2 || reg.y1 >= reg.y2)
+					full = true;
+			}
+
+			if (full)
 				reg = (struct arcan_shmif_region){
 					.x2 = src->desc.width, .y2 = src->desc.height
 				};
@@ -1114,7 +1205,29 @@ enum arcan_ffunc_rv arcan_frameserver_avfeedframe FFUNC_HEAD
 	/* only mark vready if we go the manual buffer route, otherwise the device
 	 * events act as clock */
 			if (cmd == FFUNC_READBACK){
-				memcpy(src->vbufs[0], buf, buf_sz);
+				size_t seg_sz = (size_t)
+					src->desc.width * src->desc.height * sizeof(av_pixel);
+				size_t lim = buf_sz < seg_sz ? buf_sz : seg_sz;
+
+				if (full)
+					memcpy(src->vbufs[0], buf, lim);
+				else if (reg.x1 == 0 && reg.x2 == width){
+					size_t pitch = width * sizeof(av_pixel);
+					size_t ofs = reg.y1 * pitch;
+					size_t nb = (reg.y2 - reg.y1) * pitch;
+					if (ofs + nb > lim)
+						nb = ofs < lim ? lim - ofs : 0;
+					memcpy((uint8_t*)src->vbufs[0] + ofs, (uint8_t*)buf + ofs, nb);
+				}
+				else {
+					size_t nb = (reg.x2 - reg.x1) * sizeof(av_pixel);
+					for (size_t y = reg.y1; y < reg.y2; y++){
+						size_t ofs = y * width + reg.x1;
+						if ((ofs * sizeof(av_pixel)) + nb > lim)
+							break;
+						memcpy(&src->vbufs[0][ofs], &buf[ofs], nb);
+					}
+				}
 				ev.tgt.ioevs[0].iv = src->vfcount++;
 				atomic_store(&src->shm.ptr->vready, 1);
 				platform_fsrv_pushevent(src, &ev);
@@ -1181,6 +1294,7 @@ enum arcan_ffunc_rv arcan_frameserver_avfeedframe FFUNC_HEAD
 				emit_deliveredframe(src, 0, src->desc.framecount++);
 		}
 		else {
+			src->desc.pacing.dropped++;
 			if (src->desc.callback_framestate)
 				emit_droppedframe(src, 0, src->desc.dropcount++);
 		}
@@ -1514,6 +1628,12 @@ arcan_errc arcan_frameserver_audioframe_direct(void* aobj,
 
 /* sanity check, untrusted source */
 	if (ind >= src->abuf_cnt || ind < 0){
+
+/* running dry after having delivered is an underrun, count once per gap */
+		if (ind < 0 && src->desc.pacing.audio_seen){
+			src->desc.pacing.underruns++;
+			src->desc.pacing.audio_seen = false;
+		}
 		platform_fsrv_leave();
 		return ARCAN_ERRC_NOTREADY;
 	}
@@ -1540,6 +1660,7 @@ arcan_errc arcan_frameserver_audioframe_direct(void* aobj,
 			src->desc.channels, src->desc.samplerate, tag
 		);
 
+		src->desc.pacing.audio_seen = true;
 		atomic_store(&src->shm.ptr->abufused[prev], 0);
 		int last = atomic_fetch_and_explicit(&src->shm.ptr->apending,
 				~(1 << prev), memory_order_release);
@@ -26,6 +26,39 @@ enum arcan_playstate {
 	ARCAN_PAUSED = 3
 };
 
+/*
+ * Frame pacing histograms, bucket [n] covers [2^n, 2^(n+1)) * 128 microseconds
+ * with the first bucket absorbing everything below and the last everything
+ * above.
+ *
+ * interval - time between two consecutive buffer uploads
+ * upload   - time spent inside the upload itself (push_buffer)
+ * latency  - time from the engine first seeing a frame as ready until the
+ *            display synch that presented it has finished
+ */
+#define FSRV_PACING_BUCKETS 16
+
+struct arcan_fsrv_histogram {
+	uint32_t bucket[FSRV_PACING_BUCKETS];
+	uint64_t sum;
+	uint32_t count;
+	uint32_t max;
+};
+
+struct arcan_fsrv_pacing {
+	struct arcan_fsrv_histogram interval;
+	struct arcan_fsrv_histogram upload;
+	struct arcan_fsrv_histogram latency;
+	unsigned long long dropped;
+	unsigned long long underruns;
+
+/* timestamps (us) for the frame in flight, 0 when not pending */
+	unsigned long long last_upload;
+	unsigned long long ready_ts;
+	unsigned long long pending_ts;
+	bool audio_seen;
+};
+
 /*
  * This substructure is a cache of the negotiated state, i.e.  the server side
  * view of the agreed upon use and limits of the contents of the shared memory
@@ -93,6 +126,7 @@ struct arcan_frameserver_meta {
 	unsigned long long framecount;
 	unsigned long long dropcount;
 	unsigned long long lastpts;
+	struct arcan_fsrv_pacing pacing;
 
 /* This one was added to have a way to mark objects that were created in the
  * main entrypoint of the lua scripts (that run before _adopt) but in recovery
@@ -179,6 +213,7 @@ struct arcan_frameserver {
 		bool rz_ack : 1;
 		bool locked : 1;
 		bool release_pending : 1;
+		bool herd_deferred : 1;
 		bool no_adopt : 1;
 		bool block_hdr_meta : 1;
 
@@ -228,6 +263,9 @@ struct arcan_frameserver {
 	int64_t launchedtime;
 	unsigned vfcount;
 
+/* last time the conductor released the client from a buffer lock */
+	unsigned long long last_release;
+
 /* per segment identification cookie */
 	uint32_t cookie;
 	bool cookie_fail;
@@ -528,6 +566,19 @@ void arcan_frameserver_lock_buffers(int state);
  */
 int arcan_frameserver_releaselock(struct arcan_frameserver* tgt);
 
+/*
+ * Called after the platform has synched all displays, any frame that has been
+ * uploaded but not yet presented is considered presented at [ts] (us) and its
+ * queue latency (first seen as ready -> presented) gets sampled.
+ */
+void arcan_frameserver_pacing_present(
+	struct arcan_frameserver* tgt, unsigned long long ts);
+
+/*
+ * Reset the frame pacing statistics for [tgt].
+ */
+void arcan_frameserver_pacing_reset(struct arcan_frameserver* tgt);
+
 /*
  * helper functions that tie together the platform/.../frameserver.c
  * with allocation, member matching, presets etc.
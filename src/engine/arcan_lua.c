@@ -260,6 +260,14 @@ static const int ANCHORHINT_PROXY_EXTERNAL = CONST_ANCHORHINT_PROXY_EXTERNAL;
 
 #define DBHANDLE arcan_db_get_shared(NULL)
 
+#ifndef INPUT_BATCH_LIMIT
+#define INPUT_BATCH_LIMIT 256
+#endif
+
+#ifndef INPUT_BATCH_DEFAULT
+#define INPUT_BATCH_DEFAULT 64
+#endif
+
 static struct {
 	struct nonblock_io rawres;
 
@@ -283,6 +291,18 @@ static struct {
 
 	size_t last_clock;
 
+/* io events queued up for the _input_batch entry point, the tables are
+ * registry references that are reused between calls to avoid GC churn */
+	struct {
+		arcan_ioevent buf[INPUT_BATCH_LIMIT];
+		uint16_t merged[INPUT_BATCH_LIMIT];
+		size_t count;
+		size_t limit;
+		bool coalesce;
+		intptr_t tables;
+		intptr_t samples;
+	} batch;
+
 } luactx = {0};
 
 extern char* _n_strdup(const char* instr, const char* alt);
@@ -1124,6 +1144,27 @@ static int loadimageasynch(lua_State* ctx)
 	LUA_ETRACE("load_image_asynch", NULL, 1);
 }
 
+static int imageasynchstatus(lua_State* ctx)
+{
+	LUA_TRACE("image_asynch_status");
+
+	struct arcan_video_asynchstats st;
+	arcan_video_asynchstats(&st);
+
+	lua_newtable(ctx);
+	int top = lua_gettop(ctx);
+	tblnum(ctx, "workers", st.workers, top);
+	tblnum(ctx, "queued", st.queued, top);
+	tblnum(ctx, "prioritized", st.queued_prio, top);
+	tblnum(ctx, "running", st.running, top);
+	tblnum(ctx, "completed", st.completed, top);
+	tblnum(ctx, "cancelled", st.cancelled, top);
+	tblnum(ctx, "latency_avg", st.latency_avg, top);
+	tblnum(ctx, "latency_max", st.latency_max, top);
+
+	LUA_ETRACE("image_asynch_status", NULL, 1);
+}
+
 static int imageloaded(lua_State* ctx)
 {
 	LUA_TRACE("image_loaded");
@@ -1389,6 +1430,7 @@ static int imageresizestorage(lua_State* ctx)
 			build_orthographic_matrix(rtgt->projection, x, w, h, y, 0, 1);
 
 		agp_rendertarget_viewport(rtgt->art, x, y, x+view_w, y+view_h);
+		rtgt->damage_full = true;
 		FLAG_DIRTY(vobj);
 	}
 	else
@@ -2527,6 +2569,13 @@ static int settxcos_default(lua_State* ctx)
 			arcan_vint_mirrormapping(dst->txcos, 1.0, 1.0);
 		else
 			arcan_vint_defaultmapping(dst->txcos, 1.0, 1.0);
+
+/* the defaults are relative to the store, so they need to be mapped */
+		if (dst->atlas){
+			float txcos[8];
+			memcpy(txcos, dst->txcos, sizeof(float) * 8);
+			arcan_vint_atlas_mapping(dst, txcos);
+		}
 	}
 
 	LUA_ETRACE("image_set_txcos_default", NULL, 0);
@@ -4290,14 +4339,12 @@ static const char* kindstr(int num)
 #define FLTPUSH(X,Y,Z) fltpush(msgbuf, COUNT_OF((X))-1, (char*)((X)), Y, Z)
 
 /*
- * Repack an ioevent into a table that will be added to the out stack,
- * primarly used for the normal appl_input callback, but may also come
- * nested from a frameserver.
+ * Repack an ioevent into the table at [top]. If [samples] is set, it is the
+ * stack index of a table to reuse for analog samples rather than creating a
+ * new one.
  */
-static void append_iotable(lua_State* ctx, arcan_ioevent* ev)
+static void fill_iotable(lua_State* ctx, arcan_ioevent* ev, int top, int samples)
 {
-	int top = funtable(ctx, ev->kind);
-
 	lua_pushliteral(ctx, "kind");
 	if (ev->label[0] && ev->kind != EVENT_IO_STATUS &&
 		ev->label[COUNT_OF(ev->label)-1] == '\0'){
@@ -4390,13 +4437,26 @@ static void append_iotable(lua_State* ctx, arcan_ioevent* ev)
 		tblbool(ctx, "relative", ev->input.analog.gotrel,top);
 
 		lua_pushliteral(ctx, "samples");
-		lua_createtable(ctx, ev->input.analog.nvalues, 0);
+		if (samples)
+			lua_pushvalue(ctx, samples);
+		else
+			lua_createtable(ctx, ev->input.analog.nvalues, 0);
 		int top2 = lua_gettop(ctx);
-			for (size_t i = 0; i < ev->input.analog.nvalues; i++){
+			size_t nv = ev->input.analog.nvalues;
+			if (nv > COUNT_OF(ev->input.analog.axisval))
+				nv = COUNT_OF(ev->input.analog.axisval);
+
+			for (size_t i = 0; i < nv; i++){
 				lua_pushnumber(ctx, i + 1);
 				lua_pushnumber(ctx, ev->input.analog.axisval[i]);
 				lua_rawset(ctx, top2);
 			}
+/* a reused table may have more samples left from an earlier event */
+			if (samples)
+				for (size_t i = nv; i < COUNT_OF(ev->input.analog.axisval); i++){
+					lua_pushnil(ctx);
+					lua_rawseti(ctx, top2, i + 1);
+				}
 		lua_rawset(ctx, top);
 	break;
 
@@ -4443,6 +4503,176 @@ static void append_iotable(lua_State* ctx, arcan_ioevent* ev)
 	}
 }
 
+/*
+ * Repack an ioevent into a table that will be added to the out stack,
+ * primarly used for the normal appl_input callback, but may also come
+ * nested from a frameserver.
+ */
+static void append_iotable(lua_State* ctx, arcan_ioevent* ev)
+{
+	fill_iotable(ctx, ev, funtable(ctx, ev->kind), 0);
+}
+
+static void clear_table(lua_State* ctx, int top)
+{
+	lua_pushnil(ctx);
+	while (lua_next(ctx, top)){
+		lua_pop(ctx, 1);
+		lua_pushvalue(ctx, -1);
+		lua_pushnil(ctx);
+		lua_rawset(ctx, top);
+	}
+}
+
+/* fetch (or lazily create) the table at [ind] in the table at [arr] */
+static int reuse_table(lua_State* ctx, int arr, size_t ind)
+{
+	lua_rawgeti(ctx, arr, ind);
+	if (lua_type(ctx, -1) != LUA_TTABLE){
+		lua_pop(ctx, 1);
+		lua_newtable(ctx);
+		lua_pushvalue(ctx, -1);
+		lua_rawseti(ctx, arr, ind);
+	}
+	else
+		clear_table(ctx, lua_gettop(ctx));
+
+	return lua_gettop(ctx);
+}
+
+static int16_t sat_add16(int a, int b)
+{
+	int res = a + b;
+	return res > INT16_MAX ? INT16_MAX : (res < INT16_MIN ? INT16_MIN : res);
+}
+
+/*
+ * Fold a motion sample into an earlier queued one from the same device and
+ * axis. This only looks back until the first event that isn't a motion
+ * sample, so presses and releases keep their position in the stream.
+ * Relative samples (the even slots when gotrel is set) are accumulated,
+ * absolute ones are replaced by the latest.
+ */
+static bool coalesce_ioevent(arcan_ioevent* ev)
+{
+	if (ev->kind != EVENT_IO_AXIS_MOVE && ev->kind != EVENT_IO_TOUCH)
+		return false;
+
+	for (size_t i = luactx.batch.count; i > 0; i--){
+		arcan_ioevent* dst = &luactx.batch.buf[i-1];
+		if (dst->kind != EVENT_IO_AXIS_MOVE && dst->kind != EVENT_IO_TOUCH)
+			return false;
+
+		if (dst->kind != ev->kind || dst->devid != ev->devid ||
+			dst->subid != ev->subid || dst->devkind != ev->devkind)
+			continue;
+
+		if (ev->kind == EVENT_IO_TOUCH){
+			if (dst->input.touch.active != ev->input.touch.active)
+				return false;
+			dst->input.touch = ev->input.touch;
+		}
+		else {
+			size_t nv = ev->input.analog.nvalues;
+/* [2] is 'unknown' data for the 3- sample form so that can't be merged */
+			if (dst->input.analog.gotrel != ev->input.analog.gotrel ||
+				dst->input.analog.nvalues != nv || nv == 3 ||
+				nv > COUNT_OF(ev->input.analog.axisval))
+				return false;
+
+			for (size_t j = 0; j < nv; j++){
+				if (ev->input.analog.gotrel && !(j % 2))
+					dst->input.analog.axisval[j] = sat_add16(
+						dst->input.analog.axisval[j], ev->input.analog.axisval[j]);
+				else
+					dst->input.analog.axisval[j] = ev->input.analog.axisval[j];
+			}
+		}
+
+		if (luactx.batch.merged[i-1] < UINT16_MAX)
+			luactx.batch.merged[i-1]++;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ * Deliver the queued io events to _input_batch(events, count). The events
+ * table and its members are reused on the next call, the script is expected
+ * to copy what it needs to keep.
+ */
+static void flush_input_batch(lua_State* ctx)
+{
+	size_t count = luactx.batch.count;
+	if (!count)
+		return;
+
+	luactx.batch.count = 0;
+	TRACE_MARK_ONESHOT("scripting", "input-batch", TRACE_SYS_DEFAULT, 0, count, "");
+
+/* entry point might have disappeared while events were queued */
+	if (!alt_lookup_entry(ctx, "input_batch", 11)){
+		for (size_t i = 0; i < count; i++){
+			if (alt_lookup_entry(ctx, "input", 5)){
+				append_iotable(ctx, &luactx.batch.buf[i]);
+				alt_call(ctx, CB_SOURCE_NONE, 0, 1, 0, LINE_TAG":event:input");
+			}
+		}
+		return;
+	}
+
+	if (!luactx.batch.tables){
+		lua_newtable(ctx);
+		luactx.batch.tables = luaL_ref(ctx, LUA_REGISTRYINDEX);
+		lua_newtable(ctx);
+		luactx.batch.samples = luaL_ref(ctx, LUA_REGISTRYINDEX);
+	}
+
+	lua_rawgeti(ctx, LUA_REGISTRYINDEX, luactx.batch.tables);
+	int events = lua_gettop(ctx);
+	lua_rawgeti(ctx, LUA_REGISTRYINDEX, luactx.batch.samples);
+	int samples = lua_gettop(ctx);
+
+	for (size_t i = 0; i < count; i++){
+		arcan_ioevent* ev = &luactx.batch.buf[i];
+		int top = reuse_table(ctx, events, i + 1);
+		int stop = 0;
+
+		if (ev->kind == EVENT_IO_AXIS_MOVE){
+			lua_rawgeti(ctx, samples, i + 1);
+			if (lua_type(ctx, -1) != LUA_TTABLE){
+				lua_pop(ctx, 1);
+				lua_createtable(ctx, COUNT_OF(ev->input.analog.axisval), 0);
+				lua_pushvalue(ctx, -1);
+				lua_rawseti(ctx, samples, i + 1);
+			}
+			stop = lua_gettop(ctx);
+		}
+
+		fill_iotable(ctx, ev, top, stop);
+		if (luactx.batch.merged[i])
+			tblnum(ctx, "coalesced", luactx.batch.merged[i], top);
+		lua_settop(ctx, samples);
+	}
+
+	lua_settop(ctx, events);
+	lua_pushnumber(ctx, count);
+	alt_call(ctx, CB_SOURCE_NONE, 0, 2, 0, LINE_TAG":event:input_batch");
+}
+
+static void queue_input_batch(lua_State* ctx, arcan_ioevent* ev)
+{
+	if (luactx.batch.coalesce && coalesce_ioevent(ev))
+		return;
+
+	luactx.batch.buf[luactx.batch.count] = *ev;
+	luactx.batch.merged[luactx.batch.count] = 0;
+
+	if (++luactx.batch.count >= luactx.batch.limit)
+		flush_input_batch(ctx);
+}
+
 #ifdef ARCAN_LWA
 static bool import_btype(arcan_luactx* L,
 	int top, int reset, const char* key, int mode, int fd)
@@ -4611,6 +4841,7 @@ bool arcan_lua_pushevent(lua_State* ctx, arcan_event* ev)
 	bool adopt_check = false;
 	char msgbuf[sizeof(arcan_event)+1];
 	if (!ev){
+		flush_input_batch(ctx);
 		if (alt_lookup_entry(ctx, "input_end", 9)){
 			alt_call(ctx, CB_SOURCE_NONE, 0, 0, 0, LINE_TAG":event:input_eob");
 		}
@@ -4619,8 +4850,13 @@ bool arcan_lua_pushevent(lua_State* ctx, arcan_event* ev)
 
 	if (ev->category == EVENT_IO){
 /* try to deliver the raw out-of-loop input, but defer / reinject if the
- * script can't handle it or rejects it */
+ * script can't handle it or rejects it. Input that is already batched has
+ * to be seen first and _input_batch can't run while locked, so defer until
+ * that has been flushed. */
 		if (arcan_conductor_gpus_locked()){
+			if (luactx.batch.count)
+				return false;
+
 			bool consumed = false;
 			if (alt_lookup_entry(ctx, "input_raw", 9)){
 				append_iotable(ctx, &ev->io);
@@ -4634,6 +4870,13 @@ bool arcan_lua_pushevent(lua_State* ctx, arcan_event* ev)
 			return consumed;
 		}
 
+		if (alt_lookup_entry(ctx, "input_batch", 11)){
+			lua_pop(ctx, 1);
+			queue_input_batch(ctx, &ev->io);
+			return true;
+		}
+
+		flush_input_batch(ctx);
 		if (alt_lookup_entry(ctx, "input", 5)){
 			append_iotable(ctx, &ev->io);
 			alt_call(ctx, CB_SOURCE_NONE, 0, 1, 0, LINE_TAG":event:input");
@@ -4641,6 +4884,13 @@ bool arcan_lua_pushevent(lua_State* ctx, arcan_event* ev)
 		return true;
 	}
 
+/* queued input should be seen before anything that comes after it, the same
+ * deferral as for _input_raw applies while locked */
+	if (!arcan_conductor_gpus_locked())
+		flush_input_batch(ctx);
+	else if (luactx.batch.count)
+		return false;
+
 	if (ev->category == EVENT_SYSTEM){
 		struct arcan_evctx* evctx = arcan_event_defaultctx();
 
@@ -6802,6 +7052,21 @@ static int inputremaptranslation(lua_State* ctx)
 	LUA_ETRACE("input_remap_translation", NULL, 2)
 }
 
+static int inputbatching(lua_State* ctx)
+{
+	LUA_TRACE("input_batching");
+	ssize_t limit = luaL_optnumber(ctx, 1, INPUT_BATCH_DEFAULT);
+	if (limit <= 0 || limit > INPUT_BATCH_LIMIT)
+		limit = limit <= 0 ? 1 : INPUT_BATCH_LIMIT;
+
+/* a lower limit than what is already queued flushes on the next event */
+	luactx.batch.limit = limit;
+	luactx.batch.coalesce = luaL_optbnumber(ctx, 2, false);
+
+	lua_pushnumber(ctx, limit);
+	LUA_ETRACE("input_batching", NULL, 1);
+}
+
 static int inputcap(lua_State* ctx)
 {
 	LUA_TRACE("input_capabilities");
@@ -7003,6 +7268,15 @@ static int imagemipmap(lua_State* ctx)
 	LUA_ETRACE("image_mipmap", NULL, 0);
 }
 
+static int imageatlas(lua_State* ctx)
+{
+	LUA_TRACE("image_atlas");
+	arcan_vobj_id id = luaL_checkvid(ctx, 1, NULL);
+	bool state = luaL_optbnumber(ctx, 2, true);
+	lua_pushboolean(ctx, arcan_video_atlasobject(id, state) == ARCAN_OK);
+	LUA_ETRACE("image_atlas", NULL, 1);
+}
+
 static int imagecolor(lua_State* ctx)
 {
 	LUA_TRACE("image_color");
@@ -7020,6 +7294,7 @@ static int imagecolor(lua_State* ctx)
 			agp_rendertarget_clearcolor(rtgt->art,
 				(float)cred / 255.0f, (float)cgrn / 255.0f,
 				(float)cblu / 255.0f, (float)alpha / 255.0f);
+			rtgt->damage_full = true;
 			lua_pushboolean(ctx, true);
 			LUA_ETRACE("image_color", NULL, 1);
 		}
@@ -7330,6 +7605,8 @@ void arcan_lua_shutdown(lua_State* ctx)
 	luactx.last_segreq = NULL;
 	luactx.pending_socket_label = NULL;
 	luactx.pending_socket_descr = 0;
+	luactx.batch.count = 0;
+	luactx.batch.tables = luactx.batch.samples = 0;
 
 	lua_close(ctx);
 }
@@ -7359,6 +7636,10 @@ lua_State* arcan_lua_alloc(void (*watchdog)(lua_State*, lua_Debug*))
 {
 	lua_State* res = luaL_newstate();
 	luactx.worldid_tag = LUA_NOREF;
+	luactx.batch.count = 0;
+	luactx.batch.tables = luactx.batch.samples = 0;
+	luactx.batch.limit = INPUT_BATCH_DEFAULT;
+	luactx.batch.coalesce = false;
 
 /* in the future, we need a hook here to
  * limit / "null-out" the undesired subset of the LUA API */
@@ -8594,6 +8875,61 @@ static int targetverbose(lua_State* ctx)
 	LUA_ETRACE("target_verbose", NULL, 0);
 }
 
+static void pacing_histogram(lua_State* ctx,
+	const char* key, struct arcan_fsrv_histogram* hist)
+{
+	lua_pushstring(ctx, key);
+	lua_newtable(ctx);
+	int top = lua_gettop(ctx);
+
+	tblnum(ctx, "count", hist->count, top);
+	tblnum(ctx, "max", hist->max, top);
+	tblnum(ctx, "mean", hist->count ?
+		(double)hist->sum / (double)hist->count : 0, top);
+
+	lua_pushliteral(ctx, "buckets");
+	lua_newtable(ctx);
+	for (size_t i = 0; i < FSRV_PACING_BUCKETS; i++){
+		lua_pushnumber(ctx, i + 1);
+		lua_pushnumber(ctx, hist->bucket[i]);
+		lua_rawset(ctx, -3);
+	}
+	lua_rawset(ctx, top);
+
+	lua_rawset(ctx, -3);
+}
+
+static int targetpacing(lua_State* ctx)
+{
+	LUA_TRACE("target_pacing");
+	arcan_vobject* vobj;
+	luaL_checkvid(ctx, 1, &vobj);
+	bool reset = luaL_optbnumber(ctx, 2, 0);
+
+	if (vobj->feed.state.tag != ARCAN_TAG_FRAMESERV || !vobj->feed.state.ptr)
+		arcan_fatal("target_pacing(), specified vid (arg 1) not "
+			"associated with a frameserver.");
+
+	arcan_frameserver* fsrv = vobj->feed.state.ptr;
+	struct arcan_fsrv_pacing* pc = &fsrv->desc.pacing;
+
+	lua_newtable(ctx);
+	int top = lua_gettop(ctx);
+	tblnum(ctx, "frames", fsrv->desc.framecount, top);
+	tblnum(ctx, "dropped", pc->dropped, top);
+	tblnum(ctx, "underruns", pc->underruns, top);
+	tblnum(ctx, "bucket_base", 128, top);
+
+	pacing_histogram(ctx, "interval", &pc->interval);
+	pacing_histogram(ctx, "upload", &pc->upload);
+	pacing_histogram(ctx, "latency", &pc->latency);
+
+	if (reset)
+		arcan_frameserver_pacing_reset(fsrv);
+
+	LUA_ETRACE("target_pacing", NULL, 1);
+}
+
 static int targetskipmodecfg(lua_State* ctx)
 {
 	LUA_TRACE("target_framemode");
@@ -8796,8 +9132,7 @@ static int targetstepframe(lua_State* ctx)
 /* cascade / repeat call protection, only request read if we aren't in that
  * state already - this is for the asynch behavior */
 	if (!FL_TEST(rtgt, TGTFL_READING)){
-		agp_request_readback(rtgt->color->vstore);
-		FL_SET(rtgt, TGTFL_READING);
+		arcan_vint_requestreadback(rtgt);
 		rtgt->transfc++;
 		lua_pushboolean(ctx, true);
 	}
@@ -9390,6 +9725,18 @@ static int rendertargetmetrics(lua_State* ctx)
 	lua_pushnumber(ctx, rtgt->transfc);
 	lua_rawset(ctx, -3);
 
+	lua_pushliteral(ctx, "draw_calls");
+	lua_pushnumber(ctx, rtgt->drawc);
+	lua_rawset(ctx, -3);
+
+	lua_pushliteral(ctx, "batched");
+	lua_pushnumber(ctx, rtgt->batchc);
+	lua_rawset(ctx, -3);
+
+	lua_pushliteral(ctx, "culled");
+	lua_pushnumber(ctx, rtgt->cullc);
+	lua_rawset(ctx, -3);
+
 /* get the clock horizon by sweeping all vobjects that attach to the
  * rendertarget and taking the transform with the deepest clock */
 	arcan_vobject_litem* current = rtgt->first;
@@ -9458,6 +9805,18 @@ static int rendernoclear(lua_State* ctx)
 	LUA_ETRACE("rendertarget_noclear", NULL, 1);
 }
 
+static int renderocclusion(lua_State* ctx)
+{
+	LUA_TRACE("rendertarget_occlusion");
+	arcan_vobj_id did = luaL_checkvid(ctx, 1, NULL);
+	bool cullfl = luaL_checkbnumber(ctx, 2);
+
+	lua_pushboolean(ctx,
+		arcan_video_rendertarget_setcull(did, cullfl) == ARCAN_OK);
+
+	LUA_ETRACE("rendertarget_occlusion", NULL, 1);
+}
+
 static int renderreconf(lua_State* ctx)
 {
 	LUA_TRACE("rendertarget_reconfigure");
@@ -9748,6 +10107,7 @@ static int procimage_histo(lua_State* ctx)
 
 	arcan_vobject* vobj;
 	luaL_checkvid(ctx, 2, &vobj);
+	arcan_vint_atlas_evict(vobj);
 
 	if (!vobj->vstore || vobj->vstore->txmapped == TXSTATE_OFF ||
 		!vobj->vstore->vinf.text.raw)
@@ -10322,6 +10682,7 @@ static int imagestorage(lua_State* ctx)
 
 	arcan_vobject* vobj;
 	luaL_checkvid(ctx, 1, &vobj);
+	arcan_vint_atlas_evict(vobj);
 
 	if (vobj->vstore->txmapped != TXSTATE_TEX2D){
 		arcan_warning("image_access_storage(), referenced object "
@@ -12574,6 +12935,7 @@ static const luaL_Reg tgtfuns[] = {
 {"target_framemode",           targetskipmodecfg        },
 {"target_verbose",             targetverbose            },
 {"target_synchronous",         targetsynchronous        },
+{"target_pacing",              targetpacing             },
 {"target_flags",               targetflags              },
 {"target_graphmode",           targetgraph              },
 {"target_anchorhint",          targetanchor             },
@@ -12600,6 +12962,7 @@ static const luaL_Reg tgtfuns[] = {
 {"rendertarget_bind",          renderbind               },
 {"rendertarget_attach",        renderattach             },
 {"rendertarget_noclear",       rendernoclear            },
+{"rendertarget_occlusion",     renderocclusion          },
 {"rendertarget_id",            rendertargetid           },
 {"rendertarget_range",         rendertargetrange        },
 {"rendertarget_metrics",       rendertargetmetrics      },
@@ -12658,6 +13021,7 @@ static const luaL_Reg imgfuns[] = {
 {"load_image",               loadimage          },
 {"load_image_asynch",        loadimageasynch    },
 {"image_loaded",             imageloaded        },
+{"image_asynch_status",      imageasynchstatus  },
 {"delete_image",             deleteimage        },
 {"show_image",               showimage          },
 {"hide_image",               hideimage          },
@@ -12720,6 +13084,7 @@ static const luaL_Reg imgfuns[] = {
 {"resize_cursor",            cursorsize         },
 {"image_color",              imagecolor         },
 {"image_mipmap",             imagemipmap        },
+{"image_atlas",              imageatlas         },
 {"fill_surface",             fillsurface        },
 {"alloc_surface",            allocsurface       },
 {"raw_surface",              rawsurface         },
@@ -12804,6 +13169,7 @@ static const luaL_Reg iofuns[] = {
 {"toggle_mouse_grab",   mousegrab        },
 {"input_capabilities",  inputcap         },
 {"input_samplebase",    inputbase        },
+{"input_batching",      inputbatching    },
 {"input_remap_translation", inputremaptranslation },
 {"set_led",             setled           },
 {"led_intensity",       led_intensity    },
@@ -13424,6 +13790,31 @@ fprintf(dst,
 	(int) fsrv->outqueue.eventbuf_sz,
 	qused(&fsrv->outqueue));
 
+	struct arcan_fsrv_pacing* pc = &fsrv->desc.pacing;
+fprintf(dst,
+"\tpacing = {\
+\tframes = %llu,\
+\tdropped = %llu,\
+\tunderruns = %llu,\
+\tinterval_mean = %llu,\
+\tinterval_max = %u,\
+\tupload_mean = %llu,\
+\tupload_max = %u,\
+\tlatency_mean = %llu,\
+\tlatency_max = %u},",
+	(unsigned long long) fsrv->desc.framecount,
+	pc->dropped,
+	pc->underruns,
+	pc->interval.count ?
+		(unsigned long long)(pc->interval.sum / pc->interval.count) : 0,
+	(unsigned) pc->interval.max,
+	pc->upload.count ?
+		(unsigned long long)(pc->upload.sum / pc->upload.count) : 0,
+	(unsigned) pc->upload.max,
+	pc->latency.count ?
+		(unsigned long long)(pc->latency.sum / pc->latency.count) : 0,
+	(unsigned) pc->latency.max);
+
 	fprintf(dst, "\tsource = ");
 	fput_luasafe_str(dst, fsrv->source ? fsrv->source : "NULL");
 	fprintf(dst, ",\n\tkind = ");
@@ -104,6 +104,12 @@ enum arcan_memtypes {
 
 /* context that is used to pass data to a newly created thread */
 	ARCAN_MEM_THREADCTX,
+
+/*
+ * Slabs of transformation chain steps, few and long-lived allocations
+ * that are sub-allocated by the video layer.
+ */
+	ARCAN_MEM_TRANSFORM,
 	ARCAN_MEM_ENDMARKER
 };
 
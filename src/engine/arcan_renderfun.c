@@ -634,6 +634,9 @@ static char* extract_vidref(struct text_format* prev, char* base, bool ext)
 		return NULL;
 	}
 
+/* the raw contents are copied from the store so it can't be an atlas page */
+	arcan_vint_atlas_evict(vobj);
+
 	struct agp_vstore* vs = vobj->vstore;
 	if (vs->txmapped != TXSTATE_TEX2D){
 		arcan_warning(
@@ -1295,6 +1298,7 @@ static av_pixel* process_chain(struct rcell* root, arcan_vobject* dst,
 	if (dst){
 /* manually resize the local buffer so the video_resizefeed call won't
  * do dual agp_update_vstore synchs */
+		arcan_vint_atlas_evict(dst);
 		struct agp_vstore* s = dst->vstore;
 
 		if (s->vinf.text.raw)
@@ -0,0 +1,576 @@
+/*
+ * Copyright: Björn Ståhl
+ * License: 3-Clause BSD, see COPYING file in arcan source repository.
+ * Reference: http://arcan-fe.com
+ * Description: Texture atlas for small, static video objects.
+ *
+ * Each context keeps a list of pages, regular vstores that retain a local
+ * copy of their contents, which small stores can opt in to share instead of
+ * holding a texture of their own. The object then references the page as its
+ * vstore and the txcos are rewritten to cover its region, which cuts down on
+ * texture binds and lets draws of different objects be merged by the 2D batch.
+ *
+ * Regions are allocated from horizontal shelves. Deleting objects leave holes
+ * in their shelves, and when enough of a page has been released that way it
+ * is repacked in place (sorted by height) and all the object mappings are
+ * updated to match.
+ */
+#include "arcan_hmeta.h"
+
+#ifndef ATLAS_PAGE_SIZE
+#define ATLAS_PAGE_SIZE 1024
+#endif
+
+/* stores larger than this gain too little from sharing a page */
+#ifndef ATLAS_MAX_DIM
+#define ATLAS_MAX_DIM 128
+#endif
+
+/* edge pixels are duplicated into a border around each region so filtering
+ * at the edges doesn't pick up the neighbours */
+#define ATLAS_PAD 1
+
+#define ATLAS_PAGE_AREA (ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE)
+#define ATLAS_SHELF_LIMIT (ATLAS_PAGE_SIZE / 4)
+
+struct vatlas_shelf {
+	uint16_t y, h, x;
+};
+
+struct vatlas_pack {
+	struct vatlas_shelf shelves[ATLAS_SHELF_LIMIT];
+	size_t n_shelves;
+	size_t top;
+
+/* area (including padding and unused shelf height) consumed so far */
+	size_t used;
+};
+
+struct vatlas_alloc {
+	struct vatlas_page* page;
+	arcan_vobject* vobj;
+
+/* region inside the page, excluding padding */
+	uint16_t x, y, w, h;
+
+/* mapping relative to the original store */
+	float txcos[8];
+
+/* original store properties that are restored on eviction */
+	char* source;
+	uint8_t scale, imageproc;
+
+	struct vatlas_alloc* next;
+};
+
+struct vatlas_page {
+	struct arcan_video_context* ctx;
+	struct agp_vstore* store;
+	struct vatlas_pack pack;
+
+/* area held by live regions and area released since the last repack */
+	size_t live;
+	size_t freed;
+
+	struct vatlas_alloc* allocs;
+
+	bool dirty;
+	struct agp_region dirty_region;
+
+	struct vatlas_page* next;
+};
+
+static bool pack_region(
+	struct vatlas_pack* pack, size_t w, size_t h, size_t* x, size_t* y)
+{
+	w += ATLAS_PAD * 2;
+	h += ATLAS_PAD * 2;
+
+	struct vatlas_shelf* best = NULL;
+	for (size_t i = 0; i < pack->n_shelves; i++){
+		struct vatlas_shelf* sh = &pack->shelves[i];
+		if (sh->h < h || sh->x + w > ATLAS_PAGE_SIZE)
+			continue;
+
+		if (!best || sh->h < best->h)
+			best = sh;
+	}
+
+/* don't let short regions eat into much taller shelves as long as there is
+ * room left to open a new one */
+	bool can_open = pack->n_shelves < ATLAS_SHELF_LIMIT &&
+		pack->top + h <= ATLAS_PAGE_SIZE;
+
+	if (best && best->h > h + h / 2 && can_open)
+		best = NULL;
+
+	if (!best){
+		if (!can_open)
+			return false;
+
+		best = &pack->shelves[pack->n_shelves++];
+		*best = (struct vatlas_shelf){.y = pack->top, .h = h};
+		pack->top += h;
+	}
+
+	*x = best->x + ATLAS_PAD;
+	*y = best->y + ATLAS_PAD;
+	best->x += w;
+	pack->used += w * best->h;
+
+	return true;
+}
+
+static size_t region_area(struct vatlas_alloc* alloc)
+{
+	return (alloc->w + ATLAS_PAD * 2) * (alloc->h + ATLAS_PAD * 2);
+}
+
+/*
+ * copy [w * h] pixels with [stride] from [src] into [dst] at [x, y], then
+ * fill the padding around the region with the closest edge pixel
+ */
+static void copy_region(av_pixel* dst, const av_pixel* src,
+	size_t stride, size_t x, size_t y, size_t w, size_t h)
+{
+	for (size_t row = 0; row < h; row++){
+		av_pixel* out = &dst[(y + row) * ATLAS_PAGE_SIZE + x];
+		const av_pixel* in = &src[row * stride];
+
+		memcpy(out, in, w * sizeof(av_pixel));
+		for (size_t i = 1; i <= ATLAS_PAD; i++){
+			out[-(ssize_t)i] = in[0];
+			out[w - 1 + i] = in[w - 1];
+		}
+	}
+
+	size_t span = (w + ATLAS_PAD * 2) * sizeof(av_pixel);
+	av_pixel* first = &dst[y * ATLAS_PAGE_SIZE + x - ATLAS_PAD];
+	av_pixel* last = &dst[(y + h - 1) * ATLAS_PAGE_SIZE + x - ATLAS_PAD];
+
+	for (size_t i = 1; i <= ATLAS_PAD; i++){
+		memcpy(first - i * ATLAS_PAGE_SIZE, first, span);
+		memcpy(last + i * ATLAS_PAGE_SIZE, last, span);
+	}
+}
+
+static void mark_dirty(struct vatlas_page* page,
+	size_t x1, size_t y1, size_t x2, size_t y2)
+{
+	if (!page->dirty){
+		page->dirty = true;
+		page->dirty_region = (struct agp_region){
+			.x1 = x1, .y1 = y1, .x2 = x2, .y2 = y2
+		};
+		return;
+	}
+
+	struct agp_region* r = &page->dirty_region;
+	r->x1 = x1 < r->x1 ? x1 : r->x1;
+	r->y1 = y1 < r->y1 ? y1 : r->y1;
+	r->x2 = x2 > r->x2 ? x2 : r->x2;
+	r->y2 = y2 > r->y2 ? y2 : r->y2;
+}
+
+static void map_txcos(struct vatlas_alloc* alloc, float* dst)
+{
+	float sx = (float) alloc->w / (float) ATLAS_PAGE_SIZE;
+	float sy = (float) alloc->h / (float) ATLAS_PAGE_SIZE;
+	float ox = (float) alloc->x / (float) ATLAS_PAGE_SIZE;
+	float oy = (float) alloc->y / (float) ATLAS_PAGE_SIZE;
+
+	for (size_t i = 0; i < 4; i++){
+		dst[i * 2 + 0] = ox + alloc->txcos[i * 2 + 0] * sx;
+		dst[i * 2 + 1] = oy + alloc->txcos[i * 2 + 1] * sy;
+	}
+}
+
+static bool valid_mapping(const float* txcos)
+{
+	for (size_t i = 0; i < 8; i++)
+		if (txcos[i] < 0.0 || txcos[i] > 1.0)
+			return false;
+
+	return true;
+}
+
+static struct vatlas_page* page_alloc(
+	struct arcan_video_context* ctx, uint8_t filtermode)
+{
+	struct vatlas_page* page = arcan_alloc_mem(sizeof(struct vatlas_page),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_NATURAL);
+
+	struct agp_vstore* store = arcan_alloc_mem(sizeof(struct agp_vstore),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_NATURAL);
+
+	av_pixel* buf = arcan_alloc_mem(ATLAS_PAGE_AREA * sizeof(av_pixel),
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_PAGE);
+
+	if (!page || !store || !buf){
+		arcan_mem_free(page);
+		arcan_mem_free(store);
+		arcan_mem_free(buf);
+		return NULL;
+	}
+
+	store->txmapped = TXSTATE_TEX2D;
+	store->txu = ARCAN_VTEX_CLAMP;
+	store->txv = ARCAN_VTEX_CLAMP;
+	store->filtermode = filtermode;
+	store->bpp = sizeof(av_pixel);
+	store->w = ATLAS_PAGE_SIZE;
+	store->h = ATLAS_PAGE_SIZE;
+	store->vinf.text.raw = buf;
+	store->vinf.text.s_raw = ATLAS_PAGE_AREA * sizeof(av_pixel);
+	store->refcount = 1;
+	agp_update_vstore(store, true);
+
+	page->ctx = ctx;
+	page->store = store;
+	page->next = ctx->atlas;
+	ctx->atlas = page;
+
+	return page;
+}
+
+static void page_free(struct vatlas_page* page)
+{
+	struct vatlas_page** cur = &page->ctx->atlas;
+	while (*cur && *cur != page)
+		cur = &(*cur)->next;
+
+	if (*cur)
+		*cur = page->next;
+
+/* objects that still reference the store hold their own refcount */
+	arcan_vint_drop_vstore(page->store);
+	arcan_mem_free(page);
+}
+
+struct repack_ent {
+	struct vatlas_alloc* alloc;
+	size_t x, y;
+};
+
+static int repack_cmp(const void* a, const void* b)
+{
+	const struct repack_ent* ea = a;
+	const struct repack_ent* eb = b;
+	return (int) eb->alloc->h - (int) ea->alloc->h;
+}
+
+/*
+ * pack all live regions of [page] again from scratch, tallest first, and only
+ * commit if all of them fit (which they normally will as they did before)
+ */
+static void page_repack(struct vatlas_page* page)
+{
+	size_t count = 0;
+	for (struct vatlas_alloc* cur = page->allocs; cur; cur = cur->next)
+		count++;
+
+	struct repack_ent* set = arcan_alloc_mem(
+		sizeof(struct repack_ent) * count, ARCAN_MEM_VSTRUCT,
+		ARCAN_MEM_NONFATAL | ARCAN_MEM_TEMPORARY, ARCAN_MEMALIGN_NATURAL);
+
+	av_pixel* buf = arcan_alloc_mem(ATLAS_PAGE_AREA * sizeof(av_pixel),
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_PAGE);
+
+	struct vatlas_pack* pack = arcan_alloc_mem(sizeof(struct vatlas_pack),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL |
+		ARCAN_MEM_TEMPORARY, ARCAN_MEMALIGN_NATURAL);
+
+/* if this fails there's no need to try again until more has been released */
+	page->freed = 0;
+
+	if (!set || !buf || !pack)
+		goto out;
+
+	size_t i = 0;
+	for (struct vatlas_alloc* cur = page->allocs; cur; cur = cur->next)
+		set[i++].alloc = cur;
+
+	qsort(set, count, sizeof(struct repack_ent), repack_cmp);
+
+	for (i = 0; i < count; i++)
+		if (!pack_region(pack, set[i].alloc->w, set[i].alloc->h,
+			&set[i].x, &set[i].y))
+			goto out;
+
+	av_pixel* old = page->store->vinf.text.raw;
+
+	for (i = 0; i < count; i++){
+		struct vatlas_alloc* alloc = set[i].alloc;
+		copy_region(buf, &old[alloc->y * ATLAS_PAGE_SIZE + alloc->x],
+			ATLAS_PAGE_SIZE, set[i].x, set[i].y, alloc->w, alloc->h);
+
+		alloc->x = set[i].x;
+		alloc->y = set[i].y;
+		map_txcos(alloc, alloc->vobj->txcos);
+		FLAG_DIRTY(alloc->vobj);
+	}
+
+	page->store->vinf.text.raw = buf;
+	page->pack = *pack;
+	buf = old;
+	mark_dirty(page, 0, 0, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+
+out:
+	arcan_mem_free(set);
+	arcan_mem_free(buf);
+	arcan_mem_free(pack);
+}
+
+static void release_region(struct vatlas_alloc* alloc)
+{
+	struct vatlas_page* page = alloc->page;
+	struct vatlas_alloc** cur = &page->allocs;
+
+	while (*cur && *cur != alloc)
+		cur = &(*cur)->next;
+
+	if (*cur)
+		*cur = alloc->next;
+
+	size_t area = region_area(alloc);
+	page->live -= area;
+	page->freed += area;
+
+	alloc->vobj->atlas = NULL;
+	arcan_mem_free(alloc->source);
+	arcan_mem_free(alloc);
+
+	if (!page->allocs){
+		page_free(page);
+		return;
+	}
+
+/* the shelves never reuse the space of released regions, so repack when a
+ * sizeable part of the page has been lost to holes */
+	if (page->freed >= ATLAS_PAGE_AREA / 8 && page->live * 2 < page->pack.used)
+		page_repack(page);
+}
+
+bool arcan_vint_atlas_insert(
+	struct arcan_video_context* ctx, arcan_vobject* vobj)
+{
+	struct agp_vstore* src = vobj->vstore;
+
+/* the local copy of the page contents is what makes it possible to rebuild
+ * and to evict, so that is in conflict with the conservative mode */
+	if (arcan_video_display.conservative || !src || vobj->atlas ||
+		vobj->frameset || vobj->feed.ffunc != FFUNC_FATAL ||
+		FL_TEST(vobj, FL_PRSIST) || FL_TEST(vobj, FL_RTGT) ||
+		(vobj->feed.state.tag != ARCAN_TAG_NONE &&
+		 vobj->feed.state.tag != ARCAN_TAG_IMAGE))
+		return false;
+
+/* only plain, unshared, default format stores with a local copy */
+	if (src->txmapped != TXSTATE_TEX2D || src->refcount != 1 ||
+		src->bpp != sizeof(av_pixel) || !src->vinf.text.raw ||
+		src->vinf.text.s_raw < src->w * src->h * sizeof(av_pixel) ||
+		src->vinf.text.kind != STORAGE_IMAGE_URI || src->vinf.text.tag ||
+		src->vinf.text.glid_proxy || src->dst_copy ||
+		src->vinf.text.s_fmt || src->vinf.text.d_fmt || src->vinf.text.s_type ||
+		!src->w || !src->h || src->w > ATLAS_MAX_DIM || src->h > ATLAS_MAX_DIM ||
+		src->txu == ARCAN_VTEX_REPEAT || src->txv == ARCAN_VTEX_REPEAT ||
+		(src->filtermode & ARCAN_VFILTER_MIPMAP) ||
+		arcan_vint_findrt_vstore(src))
+		return false;
+
+	if (vobj->txcos && !valid_mapping(vobj->txcos))
+		return false;
+
+	struct vatlas_alloc* alloc = arcan_alloc_mem(sizeof(struct vatlas_alloc),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_NATURAL);
+
+	if (!alloc)
+		return false;
+
+	if (!vobj->txcos){
+		vobj->txcos = arcan_alloc_mem(8 * sizeof(float),
+			ARCAN_MEM_VSTRUCT, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_SIMD);
+
+		if (!vobj->txcos){
+			arcan_mem_free(alloc);
+			return false;
+		}
+
+		arcan_vint_defaultmapping(vobj->txcos, 1.0, 1.0);
+	}
+
+/* first page with the same filtering that has room, then a new one */
+	size_t x, y;
+	struct vatlas_page* page = ctx->atlas;
+
+	for (; page; page = page->next)
+		if (page->store->filtermode == src->filtermode &&
+			pack_region(&page->pack, src->w, src->h, &x, &y))
+			break;
+
+	if (!page){
+		page = page_alloc(ctx, src->filtermode);
+		if (!page || !pack_region(&page->pack, src->w, src->h, &x, &y)){
+			arcan_mem_free(alloc);
+			return false;
+		}
+	}
+
+	copy_region(page->store->vinf.text.raw,
+		src->vinf.text.raw, src->w, x, y, src->w, src->h);
+	mark_dirty(page, x - ATLAS_PAD, y - ATLAS_PAD,
+		x + src->w + ATLAS_PAD, y + src->h + ATLAS_PAD);
+
+	*alloc = (struct vatlas_alloc){
+		.page = page,
+		.vobj = vobj,
+		.x = x, .y = y, .w = src->w, .h = src->h,
+		.source = src->vinf.text.source,
+		.scale = src->scale,
+		.imageproc = src->imageproc,
+		.next = page->allocs
+	};
+	memcpy(alloc->txcos, vobj->txcos, sizeof(float) * 8);
+
+	page->allocs = alloc;
+	page->live += region_area(alloc);
+
+/* source is carried by the allocation so it can be restored */
+	src->vinf.text.source = NULL;
+	arcan_vint_drop_vstore(src);
+
+	page->store->refcount++;
+	vobj->vstore = page->store;
+	vobj->atlas = alloc;
+	map_txcos(alloc, vobj->txcos);
+	FLAG_DIRTY(vobj);
+
+	return true;
+}
+
+bool arcan_vint_atlas_evict(arcan_vobject* vobj)
+{
+	struct vatlas_alloc* alloc = vobj->atlas;
+	if (!alloc)
+		return true;
+
+	struct vatlas_page* page = alloc->page;
+
+	struct agp_vstore* store = arcan_alloc_mem(sizeof(struct agp_vstore),
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO | ARCAN_MEM_NONFATAL,
+		ARCAN_MEMALIGN_NATURAL);
+
+	av_pixel* buf = arcan_alloc_mem(alloc->w * alloc->h * sizeof(av_pixel),
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_PAGE);
+
+	if (!store || !buf){
+		arcan_mem_free(store);
+		arcan_mem_free(buf);
+		return false;
+	}
+
+	av_pixel* in = page->store->vinf.text.raw;
+	for (size_t row = 0; row < alloc->h; row++)
+		memcpy(&buf[row * alloc->w],
+			&in[(alloc->y + row) * ATLAS_PAGE_SIZE + alloc->x],
+			alloc->w * sizeof(av_pixel));
+
+	store->txmapped = TXSTATE_TEX2D;
+	store->txu = page->store->txu;
+	store->txv = page->store->txv;
+	store->filtermode = page->store->filtermode;
+	store->scale = alloc->scale;
+	store->imageproc = alloc->imageproc;
+	store->bpp = sizeof(av_pixel);
+	store->w = alloc->w;
+	store->h = alloc->h;
+	store->vinf.text.raw = buf;
+	store->vinf.text.s_raw = alloc->w * alloc->h * sizeof(av_pixel);
+	store->vinf.text.kind = STORAGE_IMAGE_URI;
+	store->vinf.text.source = alloc->source;
+	store->refcount = 1;
+	agp_update_vstore(store, true);
+
+	alloc->source = NULL;
+	memcpy(vobj->txcos, alloc->txcos, sizeof(float) * 8);
+	vobj->vstore = store;
+
+/* the page holds a reference of its own so this won't free it */
+	arcan_vint_drop_vstore(page->store);
+	release_region(alloc);
+	FLAG_DIRTY(vobj);
+
+	return true;
+}
+
+void arcan_vint_atlas_release(arcan_vobject* vobj)
+{
+	if (vobj->atlas)
+		release_region(vobj->atlas);
+}
+
+bool arcan_vint_atlas_mapping(arcan_vobject* vobj, const float* src)
+{
+	struct vatlas_alloc* alloc = vobj->atlas;
+	if (!alloc || !valid_mapping(src))
+		return false;
+
+	memcpy(alloc->txcos, src, sizeof(float) * 8);
+	map_txcos(alloc, vobj->txcos);
+	FLAG_DIRTY(vobj);
+
+	return true;
+}
+
+const float* arcan_vint_atlas_txcos(arcan_vobject* vobj)
+{
+	return vobj->atlas ? vobj->atlas->txcos : NULL;
+}
+
+void arcan_vint_atlas_dimensions(arcan_vobject* vobj, size_t* w, size_t* h)
+{
+	if (!vobj->atlas)
+		return;
+
+	*w = vobj->atlas->w;
+	*h = vobj->atlas->h;
+}
+
+void arcan_vint_atlas_flush(struct arcan_video_context* ctx)
+{
+	for (struct vatlas_page* page = ctx->atlas; page; page = page->next){
+		if (!page->dirty)
+			continue;
+
+		struct agp_region* r = &page->dirty_region;
+		struct stream_meta meta = {
+			.buf = page->store->vinf.text.raw,
+			.dirty = true,
+			.x1 = r->x1, .y1 = r->y1,
+			.w = r->x2 - r->x1, .h = r->y2 - r->y1
+		};
+
+		meta = agp_stream_prepare(page->store, meta, STREAM_RAW_DIRECT_SYNCHRONOUS);
+		agp_stream_commit(page->store, meta);
+		page->dirty = false;
+	}
+}
+
+void arcan_vint_atlas_suspend(struct arcan_video_context* ctx)
+{
+	for (struct vatlas_page* page = ctx->atlas; page; page = page->next)
+		agp_null_vstore(page->store);
+}
+
+void arcan_vint_atlas_resume(struct arcan_video_context* ctx)
+{
+	for (struct vatlas_page* page = ctx->atlas; page; page = page->next){
+		agp_update_vstore(page->store, true);
+		page->dirty = false;
+	}
+}
@@ -4,6 +4,8 @@
  * Reference: http://arcan-fe.com
  */
 
+#include <stdatomic.h>
+
 #include "arcan_hmeta.h"
 #include "arcan_ttf.h"
 
@@ -13,6 +15,24 @@
 #define ASYNCH_CONCURRENT_THREADS 12
 #endif
 
+/* worker threads (in addition to the main thread) for the interpolation pass
+ * of the tick, and the number of tracked objects needed to bother with them */
+#ifndef TICK_CONCURRENT_THREADS
+#define TICK_CONCURRENT_THREADS 3
+#endif
+
+#ifndef TICK_PARALLEL_THRESHOLD
+#define TICK_PARALLEL_THRESHOLD 512
+#endif
+
+#define TICK_PARALLEL_CHUNK 64
+
+/* number of opaque objects per rendertarget pass that are considered as
+ * occluders when culling is enabled, the largest ones are kept */
+#ifndef OCCLUSION_LIMIT
+#define OCCLUSION_LIMIT 16
+#endif
+
 #ifndef offsetof
 #define offsetof(type, member) ((size_t)((char*)&(*(type*)0).member\
  - (char*)&(*(type*)0)))
@@ -111,6 +131,86 @@ static const char* video_tracetag(arcan_vobject* src)
 /* a default more-or-less empty context */
 static struct arcan_video_context* current_context = vcontext_stack;
 
+enum tick_work {
+	TICK_TRANSFORM = 1,
+	TICK_FFUNC = 2,
+	TICK_FRAMESET = 4,
+	TICK_LIFETIME = 8,
+	TICK_ASYNCH = 16
+};
+
+static uint8_t tick_work(arcan_vobject* vobj)
+{
+	uint8_t work = 0;
+
+	if (vobj->transform)
+		work |= TICK_TRANSFORM;
+
+	if (vobj->feed.ffunc)
+		work |= TICK_FFUNC;
+
+	if (vobj->frameset && vobj->frameset->mctr != 0)
+		work |= TICK_FRAMESET;
+
+	if (vobj->lifetime > 0)
+		work |= TICK_LIFETIME;
+
+	if (vobj->feed.state.tag == ARCAN_TAG_ASYNCIMGLD ||
+		vobj->feed.state.tag == ARCAN_TAG_ASYNCIMGRD)
+		work |= TICK_ASYNCH;
+
+	return work;
+}
+
+static void tickset_alloc(struct arcan_video_context* ctx)
+{
+	ctx->ticks.count = 0;
+	ctx->ticks.id = arcan_alloc_mem(sizeof(arcan_vobj_id) * ctx->vitem_limit,
+		ARCAN_MEM_VSTRUCT, 0, ARCAN_MEMALIGN_NATURAL);
+	ctx->ticks.work = arcan_alloc_mem(ctx->vitem_limit,
+		ARCAN_MEM_VSTRUCT, 0, ARCAN_MEMALIGN_NATURAL);
+	ctx->ticks.xfer = arcan_alloc_mem(ctx->vitem_limit,
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+	ctx->ticks.slot = arcan_alloc_mem(sizeof(uint32_t) * ctx->vitem_limit,
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+}
+
+static void tickset_free(struct arcan_video_context* ctx)
+{
+	arcan_mem_free(ctx->ticks.id);
+	arcan_mem_free(ctx->ticks.work);
+	arcan_mem_free(ctx->ticks.xfer);
+	arcan_mem_free(ctx->ticks.slot);
+	ctx->ticks = (struct vobject_tickset){0};
+}
+
+/*
+ * (re-)derive the pending work for [vobj] and add it to the tickset if it
+ * isn't already there, call whenever some per-tick state goes from off to on
+ */
+static void tick_track(struct arcan_video_context* ctx, arcan_vobject* vobj)
+{
+	struct vobject_tickset* ts = &ctx->ticks;
+	if (!ts->slot || vobj->cellid <= 0 || vobj->cellid >= ctx->vitem_limit)
+		return;
+
+	uint8_t work = tick_work(vobj);
+	uint32_t slot = ts->slot[vobj->cellid];
+
+	if (slot){
+		ts->work[slot - 1] = work;
+		return;
+	}
+
+	if (!work)
+		return;
+
+/* one entry per cellid so this can't overflow */
+	ts->id[ts->count] = vobj->cellid;
+	ts->work[ts->count] = work;
+	ts->slot[vobj->cellid] = ++ts->count;
+}
+
 void arcan_vint_drop_vstore(struct agp_vstore* s)
 {
 	assert(s->refcount);
@@ -150,14 +250,62 @@ void arcan_video_default_imageprocmode(enum arcan_imageproc_mode mode)
 	arcan_video_display.imageproc = mode;
 }
 
+static inline size_t ptr_hash(const void* ptr)
+{
+	uint64_t v = (uintptr_t) ptr;
+	v ^= v >> 33;
+	v *= 0xff51afd7ed558ccdULL;
+	v ^= v >> 33;
+	return v;
+}
+
+static void rtgt_index_insert(uint16_t* tbl, const void* key, size_t ind)
+{
+	size_t mask = RENDERTARGET_HASH - 1;
+	size_t pos = ptr_hash(key) & mask;
+
+	while (tbl[pos])
+		pos = (pos + 1) & mask;
+
+	tbl[pos] = ind + 1;
+}
+
+/*
+ * rtargets[] gets compacted when one is dropped so the indices can't be
+ * patched in place, with the limit being what it is a rebuild is cheaper
+ * than tracking the moves
+ */
+static void rtgt_reindex(struct arcan_video_context* ctx)
+{
+	ctx->rtgt_order_dirty = true;
+	memset(ctx->rtgt_byobj, '\0', sizeof(ctx->rtgt_byobj));
+	memset(ctx->rtgt_bystore, '\0', sizeof(ctx->rtgt_bystore));
+
+	for (size_t i = 0; i < ctx->n_rtargets; i++){
+		arcan_vobject* color = ctx->rtargets[i].color;
+		if (!color)
+			continue;
+
+		rtgt_index_insert(ctx->rtgt_byobj, color, i);
+		if (color->vstore)
+			rtgt_index_insert(ctx->rtgt_bystore, color->vstore, i);
+	}
+}
+
 struct rendertarget* arcan_vint_findrt_vstore(struct agp_vstore* st)
 {
 	if (!st)
 		return NULL;
 
-	for (size_t i = 0; i < current_context->n_rtargets && st; i++)
-		if (current_context->rtargets[i].color->vstore == st)
-			return &current_context->rtargets[i];
+	size_t mask = RENDERTARGET_HASH - 1;
+	for (size_t pos = ptr_hash(st) & mask;
+		current_context->rtgt_bystore[pos]; pos = (pos + 1) & mask){
+		struct rendertarget* tgt =
+			&current_context->rtargets[current_context->rtgt_bystore[pos] - 1];
+
+		if (tgt->color->vstore == st)
+			return tgt;
+	}
 
 	if (current_context->stdoutp.color &&
 		st == current_context->stdoutp.color->vstore)
@@ -167,9 +315,18 @@ struct rendertarget* arcan_vint_findrt_vstore(struct agp_vstore* st)
 
 struct rendertarget* arcan_vint_findrt(arcan_vobject* vobj)
 {
-	for (size_t i = 0; i < current_context->n_rtargets && vobj; i++)
-		if (current_context->rtargets[i].color == vobj)
-			return &current_context->rtargets[i];
+	if (!vobj)
+		return NULL;
+
+	size_t mask = RENDERTARGET_HASH - 1;
+	for (size_t pos = ptr_hash(vobj) & mask;
+		current_context->rtgt_byobj[pos]; pos = (pos + 1) & mask){
+		struct rendertarget* tgt =
+			&current_context->rtargets[current_context->rtgt_byobj[pos] - 1];
+
+		if (tgt->color == vobj)
+			return tgt;
+	}
 
 	if (vobj == &current_context->world)
 		return &current_context->stdoutp;
@@ -177,6 +334,148 @@ struct rendertarget* arcan_vint_findrt(arcan_vobject* vobj)
 	return NULL;
 }
 
+/*
+ * Index of attachments, (rendertarget key, vobject) to the list item that
+ * links them so that detaching doesn't need to walk the rendertarget list.
+ * The key is assigned when the rendertarget is created and can't be changed
+ * from the scripting layer (unlike the id), it is used rather than the
+ * pointer as rtargets[] moves around. The index is shared between context
+ * layers so keys are unique across them. Linear probing with backward shift
+ * deletion, so no tombstones.
+ */
+struct attach_slot {
+	arcan_vobject* elem;
+	uint64_t rtkey;
+	arcan_vobject_litem* item;
+};
+
+static struct {
+	struct attach_slot* slots;
+	size_t size;
+	size_t used;
+	uint64_t next_key;
+} attach_index;
+
+static inline size_t attach_hash(uint64_t rtkey, arcan_vobject* elem)
+{
+	return ptr_hash(elem) ^ (size_t)(rtkey * 0x9e3779b97f4a7c15ULL);
+}
+
+static uint64_t attach_key()
+{
+	return ++attach_index.next_key;
+}
+
+static void attach_index_grow()
+{
+	struct attach_slot* old = attach_index.slots;
+	size_t old_sz = attach_index.size;
+
+	attach_index.size = old_sz ? old_sz * 2 : 256;
+	attach_index.slots = arcan_alloc_mem(
+		sizeof(struct attach_slot) * attach_index.size,
+		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+
+	size_t mask = attach_index.size - 1;
+	for (size_t i = 0; i < old_sz; i++){
+		if (!old[i].elem)
+			continue;
+
+		size_t pos = attach_hash(old[i].rtkey, old[i].elem) & mask;
+		while (attach_index.slots[pos].elem)
+			pos = (pos + 1) & mask;
+		attach_index.slots[pos] = old[i];
+	}
+
+	arcan_mem_free(old);
+}
+
+static void attach_index_insert(
+	struct rendertarget* dst, arcan_vobject_litem* item)
+{
+	if ((attach_index.used + 1) * 2 > attach_index.size)
+		attach_index_grow();
+
+	size_t mask = attach_index.size - 1;
+	size_t pos = attach_hash(dst->attach_key, item->elem) & mask;
+
+	while (attach_index.slots[pos].elem)
+		pos = (pos + 1) & mask;
+
+	attach_index.slots[pos] = (struct attach_slot){
+		.elem = item->elem,
+		.rtkey = dst->attach_key,
+		.item = item
+	};
+	attach_index.used++;
+	item->elem->extrefc.lists++;
+}
+
+static ssize_t attach_index_pos(struct rendertarget* dst, arcan_vobject* elem)
+{
+	if (!attach_index.size)
+		return -1;
+
+	size_t mask = attach_index.size - 1;
+	for (size_t pos = attach_hash(dst->attach_key, elem) & mask;
+		attach_index.slots[pos].elem; pos = (pos + 1) & mask){
+		if (attach_index.slots[pos].elem == elem &&
+			attach_index.slots[pos].rtkey == dst->attach_key)
+			return pos;
+	}
+
+	return -1;
+}
+
+static void attach_index_remove(struct rendertarget* dst, arcan_vobject* elem)
+{
+	ssize_t pos = attach_index_pos(dst, elem);
+	if (-1 == pos)
+		return;
+
+	size_t mask = attach_index.size - 1;
+	size_t hole = pos;
+	attach_index.used--;
+	elem->extrefc.lists--;
+
+/* shift back any entry further down the probe sequence that could live in
+ * the hole, stop at the first empty slot */
+	for (size_t cur = (hole + 1) & mask;
+		attach_index.slots[cur].elem; cur = (cur + 1) & mask){
+		size_t home = attach_hash(
+			attach_index.slots[cur].rtkey, attach_index.slots[cur].elem) & mask;
+
+		if (((cur - home) & mask) >= ((cur - hole) & mask)){
+			attach_index.slots[hole] = attach_index.slots[cur];
+			hole = cur;
+		}
+	}
+
+	attach_index.slots[hole] = (struct attach_slot){0};
+}
+
+bool arcan_vint_readback_source(arcan_vobject* vobj)
+{
+	struct rendertarget* own = arcan_vint_findrt(vobj);
+	if (own && own->readback)
+		return true;
+
+	if (!vobj->extrefc.lists)
+		return false;
+
+	for (size_t i = 0; i < current_context->n_rtargets; i++){
+		struct rendertarget* tgt = &current_context->rtargets[i];
+		if (!tgt->readback)
+			continue;
+
+		if (-1 != attach_index_pos(tgt, vobj) ||
+			(tgt->link && -1 != attach_index_pos(tgt->link, vobj)))
+			return true;
+	}
+
+	return false;
+}
+
 static void addchild(arcan_vobject* parent, arcan_vobject* child)
 {
 	arcan_vobject** slot = NULL;
@@ -269,15 +568,19 @@ static void deallocate_gl_context(
  * but not for the cases where we share store with the world */
 			else if (
 				!FL_TEST(current, FL_PRSIST) && !FL_TEST(current, FL_RTGT) &&
-				current->vstore != safe_store)
+				current->vstore != safe_store && !current->atlas)
 				agp_null_vstore(current->vstore);
 		}
 	}
 
+	if (!del)
+		arcan_vint_atlas_suspend(context);
+
 /* pool is dynamically sized and size is set on layer push */
 	if (del){
 		arcan_mem_free(context->vitems_pool);
 		context->vitems_pool = NULL;
+		tickset_free(context);
 	}
 }
 
@@ -312,6 +615,7 @@ static void reallocate_gl_context(struct arcan_video_context* context)
 		context->vitems_pool = arcan_alloc_mem(
 			sizeof(struct arcan_vobject) * context->vitem_limit,
 				ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+		tickset_alloc(context);
 	}
 	else for (size_t i = 1; i < context->vitem_limit; i++)
 		if (FL_TEST(&(context->vitems_pool[i]), FL_INUSE)){
@@ -340,7 +644,7 @@ static void reallocate_gl_context(struct arcan_video_context* context)
 				arcan_mem_free(fname);
 			}
 			else
-				if (current->vstore->txmapped != TXSTATE_OFF)
+				if (current->vstore->txmapped != TXSTATE_OFF && !current->atlas)
 					agp_update_vstore(current->vstore, true);
 
 			arcan_frameserver* fsrv = current->feed.state.ptr;
@@ -350,6 +654,8 @@ static void reallocate_gl_context(struct arcan_video_context* context)
 				arcan_audio_play(fsrv->aid, false, 0.0, -2); /* -2 == LUA_NOREF */
 			}
 		}
+
+	arcan_vint_atlas_resume(context);
 }
 
 unsigned arcan_video_nfreecontexts()
@@ -394,6 +700,7 @@ static void push_transfer_persists(
 		dst->nalive++; /* fake allocate */
 		dstobj->parent = &dst->world; /* don't cross- reference worlds */
 		attach_object(&dst->stdoutp, dstobj);
+		tick_track(dst, dstobj);
 		trace("vcontext_stack_push() : transfer-attach: %s\n", srcobj->tracetag);
 	}
 }
@@ -422,6 +729,7 @@ static void pop_transfer_persists(
 		memcpy(dstobj, srcobj, sizeof(arcan_vobject));
 		attach_object(&dst->stdoutp, dstobj);
 		dstobj->parent = parent;
+		tick_track(dst, dstobj);
 		memset(srcobj, '\0', sizeof(arcan_vobject));
 	}
 }
@@ -617,13 +925,17 @@ signed arcan_video_pushcontext()
 	current_context->stdoutp.vppcm = current_context->stdoutp.hppcm = 28;
 	current_context->stdoutp.color = &current_context->world;
 	current_context->stdoutp.max_order = 65536;
+	current_context->stdoutp.attach_key = attach_key();
 	current_context->vitem_limit = arcan_video_display.default_vitemlim;
 	current_context->vitems_pool = arcan_alloc_mem(
 		sizeof(struct arcan_vobject) * current_context->vitem_limit,
 		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL
 	);
+	tickset_alloc(current_context);
+	current_context->atlas = NULL;
 
 	current_context->rtargets[0].first = NULL;
+	rtgt_reindex(current_context);
 
 /* propagate persistent flagged objects upwards */
 	push_transfer_persists(
@@ -755,6 +1067,7 @@ clense:
 		vobj->vstore = alim[i].gl_store;
 		vobj->feed.state = alim[i].state;
 		vobj->feed.ffunc = alim[i].ffunc;
+		tick_track(current_context, vobj);
 		vobj->origw = alim[i].origw;
 		vobj->origh = alim[i].origh;
 /*		vobj->order = alim[i].zv;
@@ -936,6 +1249,9 @@ arcan_errc arcan_video_resampleobject(arcan_vobj_id vid,
 	if (vobj->vstore->txmapped != TXSTATE_TEX2D)
 		return ARCAN_ERRC_UNACCEPTED_STATE;
 
+	if (!arcan_vint_atlas_evict(vobj))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 	arcan_vobj_id xfer = arcan_video_nullobject(neww, newh, 0);
 	if (xfer == ARCAN_EID)
 		return ARCAN_ERRC_OUT_OF_SPACE;
@@ -1037,12 +1353,31 @@ arcan_errc arcan_video_resampleobject(arcan_vobj_id vid,
 	return ARCAN_OK;
 }
 
+arcan_errc arcan_video_atlasobject(arcan_vobj_id vid, bool state)
+{
+	arcan_vobject* vobj = arcan_video_getobject(vid);
+	if (!vobj)
+		return ARCAN_ERRC_NO_SUCH_OBJECT;
+
+	if (!state)
+		return arcan_vint_atlas_evict(vobj) ? ARCAN_OK : ARCAN_ERRC_OUT_OF_SPACE;
+
+	if (vobj->atlas)
+		return ARCAN_OK;
+
+	return arcan_vint_atlas_insert(current_context, vobj) ?
+		ARCAN_OK : ARCAN_ERRC_UNACCEPTED_STATE;
+}
+
 arcan_errc arcan_video_mipmapset(arcan_vobj_id vid, bool enable)
 {
 	arcan_vobject* vobj = arcan_video_getobject(vid);
 	if (!vobj)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	if (!arcan_vint_atlas_evict(vobj))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 	if (vobj->vstore->txmapped != TXSTATE_TEX2D ||
 		!vobj->vstore->vinf.text.raw)
 		return ARCAN_ERRC_UNACCEPTED_STATE;
@@ -1215,16 +1550,14 @@ static bool detach_fromtarget(struct rendertarget* dst, arcan_vobject* src)
 		dst->camtag = ARCAN_EID;
 
 /* find it */
-	torem = dst->first;
-	while(torem){
-		if (torem->elem == src)
-			break;
-
-		torem = torem->next;
-	}
-	if (!torem)
+	ssize_t pos = attach_index_pos(dst, src);
+	if (-1 == pos)
 		return false;
 
+	torem = attach_index.slots[pos].item;
+	attach_index_remove(dst, src);
+	current_context->rtgt_order_dirty = true;
+
 /* (1.) remove first */
 	if (dst->first == torem){
 		dst->first = torem->next;
@@ -1326,6 +1659,8 @@ static void attach_object(struct rendertarget* dst, arcan_vobject* src)
 
 	new_litem->next = new_litem->previous = NULL;
 	new_litem->elem = src;
+	attach_index_insert(dst, new_litem);
+	current_context->rtgt_order_dirty = true;
 
 /* (pre) if orphaned, assign */
 	if (src->owner == NULL){
@@ -1427,6 +1762,47 @@ arcan_errc arcan_vint_dropshape(arcan_vobject* vobj)
 	return ARCAN_OK;
 }
 
+/*
+ * Transformation steps are allocated and released at a high rate when many
+ * objects are being animated, so they are served from slabs that are kept
+ * around for the lifetime of the process, with released steps on a free-list.
+ * Only the main thread modifies chains so there is no locking.
+ */
+#ifndef TRANSFORM_SLAB_SIZE
+#define TRANSFORM_SLAB_SIZE 256
+#endif
+
+static struct {
+	surface_transform* free;
+} transform_pool;
+
+static surface_transform* transform_alloc()
+{
+	if (!transform_pool.free){
+		surface_transform* slab = arcan_alloc_mem(
+			sizeof(surface_transform) * TRANSFORM_SLAB_SIZE,
+			ARCAN_MEM_TRANSFORM, 0, ARCAN_MEMALIGN_NATURAL);
+
+		for (size_t i = 0; i < TRANSFORM_SLAB_SIZE - 1; i++)
+			slab[i].next = &slab[i + 1];
+		slab[TRANSFORM_SLAB_SIZE - 1].next = NULL;
+
+		transform_pool.free = slab;
+	}
+
+	surface_transform* res = transform_pool.free;
+	transform_pool.free = res->next;
+
+	memset(res, '\0', sizeof(surface_transform));
+	return res;
+}
+
+static void transform_free(surface_transform* step)
+{
+	step->next = transform_pool.free;
+	transform_pool.free = step;
+}
+
 /* run through the chain and delete all occurences at ofs */
 static void swipe_chain(surface_transform* base, unsigned ofs, unsigned size)
 {
@@ -1443,9 +1819,7 @@ static surface_transform* dup_chain(surface_transform* base)
 	if (!base)
 		return NULL;
 
-	surface_transform* res = arcan_alloc_mem( sizeof(surface_transform),
-		ARCAN_MEM_VSTRUCT, 0, ARCAN_MEMALIGN_NATURAL);
-
+	surface_transform* res = transform_alloc();
 	surface_transform* current = res;
 
 	while (base)
@@ -1453,8 +1827,7 @@ static surface_transform* dup_chain(surface_transform* base)
 		memcpy(current, base, sizeof(surface_transform));
 
 		if (base->next)
-			current->next = arcan_alloc_mem( sizeof(surface_transform),
-			ARCAN_MEM_VSTRUCT, 0, ARCAN_MEMALIGN_NATURAL);
+			current->next = transform_alloc();
 		else
 			current->next = NULL;
 
@@ -1635,6 +2008,7 @@ arcan_errc arcan_video_init(uint16_t width, uint16_t height, uint8_t bpp,
 	current_context->vitems_pool = arcan_alloc_mem(
 		sizeof(struct arcan_vobject) * current_context->vitem_limit,
 		ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+	tickset_alloc(current_context);
 
 	struct monitor_mode mode = platform_video_dimensions();
 	if (mode.width == 0 || mode.height == 0){
@@ -1865,6 +2239,7 @@ arcan_errc arcan_video_framecyclemode(arcan_vobj_id id, int mode)
 		return ARCAN_ERRC_UNACCEPTED_STATE;
 
 	vobj->frameset->ctr = vobj->frameset->mctr = abs(mode);
+	tick_track(current_context, vobj);
 
 	return ARCAN_OK;
 }
@@ -1896,7 +2271,8 @@ void arcan_video_cursorstore(arcan_vobj_id src)
 
 	arcan_vobject* vobj = arcan_video_getobject(src);
 	if (src == ARCAN_VIDEO_WORLDID || !vobj ||
-		vobj->vstore->txmapped != TXSTATE_TEX2D)
+		vobj->vstore->txmapped != TXSTATE_TEX2D ||
+		!arcan_vint_atlas_evict(vobj))
 		return;
 
 /* texture coordinates are managed separately through _display.cursor_txcos */
@@ -1912,8 +2288,13 @@ arcan_errc arcan_video_shareglstore(arcan_vobj_id sid, arcan_vobj_id did)
 	if (!src || !dst || src == dst)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	if (!arcan_vint_atlas_evict(src))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 /* remove the original target store, substitute in our own */
+	arcan_vint_atlas_release(dst);
 	arcan_vint_drop_vstore(dst->vstore);
+	current_context->rtgt_order_dirty = true;
 
 	struct rendertarget* rtgt = arcan_vint_findrt(dst);
 
@@ -1943,6 +2324,9 @@ arcan_errc arcan_video_shareglstore(arcan_vobj_id sid, arcan_vobj_id did)
 	dst->vstore = src->vstore;
 	dst->vstore->refcount++;
 
+	if (rtgt)
+		rtgt_reindex(current_context);
+
 /* customized texture coordinates unless we should use defaults ... */
 	if (src->txcos){
 		if (!dst->txcos)
@@ -2117,11 +2501,9 @@ arcan_errc arcan_video_detachfromrendertarget(arcan_vobj_id did,
 		return ARCAN_OK;
 	}
 
-	for (size_t ind = 0; ind < current_context->n_rtargets; ind++){
-		if (current_context->rtargets[ind].color == dstobj &&
-			srcobj->owner != &current_context->rtargets[ind])
-				detach_fromtarget(&current_context->rtargets[ind], srcobj);
-	}
+	struct rendertarget* rtgt = arcan_vint_findrt(dstobj);
+	if (rtgt && rtgt != &current_context->stdoutp && srcobj->owner != rtgt)
+		detach_fromtarget(rtgt, srcobj);
 
 	return ARCAN_OK;
 }
@@ -2159,22 +2541,19 @@ arcan_errc arcan_video_attachtorendertarget(
 		return ARCAN_OK;
 	}
 
-/* linear search for rendertarget matching the destination id */
-	for (size_t ind = 0; ind < current_context->n_rtargets; ind++){
-		if (current_context->rtargets[ind].color == dstobj){
+	struct rendertarget* rtgt = arcan_vint_findrt(dstobj);
+	if (!rtgt || rtgt == &current_context->stdoutp)
+		return ARCAN_ERRC_BAD_ARGUMENT;
+
 /* find whatever rendertarget we're already attached to, and detach */
-			if (srcobj->owner && detach)
-				detach_fromtarget(srcobj->owner, srcobj);
+	if (srcobj->owner && detach)
+		detach_fromtarget(srcobj->owner, srcobj);
 
 /* try and detach (most likely fail) to make sure that we don't get duplicates*/
-			detach_fromtarget(&current_context->rtargets[ind], srcobj);
-			attach_object(&current_context->rtargets[ind], srcobj);
-
-			return ARCAN_OK;
-		}
-	}
+	detach_fromtarget(rtgt, srcobj);
+	attach_object(rtgt, srcobj);
 
-	return ARCAN_ERRC_BAD_ARGUMENT;
+	return ARCAN_OK;
 }
 
 arcan_errc arcan_video_defaultattachment(arcan_vobj_id src)
@@ -2207,6 +2586,7 @@ arcan_errc arcan_video_alterreadback(arcan_vobj_id did, int readback)
 {
 	if (did == ARCAN_VIDEO_WORLDID){
 		current_context->stdoutp.readback = readback;
+		current_context->stdoutp.readback_full = true;
 		return ARCAN_OK;
 	}
 
@@ -2220,6 +2600,7 @@ arcan_errc arcan_video_alterreadback(arcan_vobj_id did, int readback)
 
 	rtgt->readback = readback;
 	rtgt->readcnt = abs(readback);
+	rtgt->readback_full = true;
 	return ARCAN_OK;
 }
 
@@ -2248,6 +2629,7 @@ arcan_errc arcan_video_rendertarget_range(
 
 	rtgt->min_order = min;
 	rtgt->max_order = max;
+	rtgt->damage_full = true;
 
 	return ARCAN_OK;
 }
@@ -2277,6 +2659,31 @@ arcan_errc arcan_video_rendertarget_setnoclear(arcan_vobj_id did, bool value)
 	return ARCAN_OK;
 }
 
+arcan_errc arcan_video_rendertarget_setcull(arcan_vobj_id did, bool value)
+{
+	struct rendertarget* rtgt;
+
+	if (did == ARCAN_VIDEO_WORLDID)
+		rtgt = &current_context->stdoutp;
+	else {
+		arcan_vobject* vobj = arcan_video_getobject(did);
+		if (!vobj)
+			return ARCAN_ERRC_NO_SUCH_OBJECT;
+
+		rtgt = arcan_vint_findrt(vobj);
+	}
+
+	if (!rtgt)
+		return ARCAN_ERRC_NO_SUCH_OBJECT;
+
+	if (value)
+		FL_SET(rtgt, TGTFL_CULL);
+	else
+		FL_CLEAR(rtgt, TGTFL_CULL);
+
+	return ARCAN_OK;
+}
+
 arcan_errc arcan_video_linkrendertarget(arcan_vobj_id did,
 	arcan_vobj_id tgt_id, int refresh, bool scale, enum rendertarget_mode format)
 {
@@ -2305,6 +2712,7 @@ arcan_errc arcan_video_linkrendertarget(arcan_vobj_id did,
 		return ARCAN_ERRC_BAD_ARGUMENT;
 
 	newtgt->link = tgt;
+	current_context->rtgt_order_dirty = true;
 	return ARCAN_OK;
 }
 
@@ -2324,6 +2732,9 @@ arcan_errc arcan_video_setuprendertarget(arcan_vobj_id did,
 		return rv;
 	}
 
+	if (!arcan_vint_atlas_evict(vobj))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 /* hard-coded number of render-targets allowed */
 	if (current_context->n_rtargets >= RENDERTARGET_LIMIT)
 		return ARCAN_ERRC_OUT_OF_SPACE;
@@ -2335,6 +2746,9 @@ arcan_errc arcan_video_setuprendertarget(arcan_vobj_id did,
 	FL_SET(vobj, FL_RTGT);
 	FL_SET(dst, TGTFL_ALIVE);
 	dst->color = vobj;
+	rtgt_index_insert(current_context->rtgt_byobj, vobj, ind);
+	rtgt_index_insert(current_context->rtgt_bystore, vobj->vstore, ind);
+	current_context->rtgt_order_dirty = true;
 	dst->camtag = ARCAN_EID;
 	dst->readback = readback;
 	dst->readcnt = abs(readback);
@@ -2347,10 +2761,13 @@ arcan_errc arcan_video_setuprendertarget(arcan_vobj_id did,
 	dst->vppcm = dst->hppcm = 28.346456692913385;
 	dst->min_order = 0;
 	dst->max_order = 65536;
+	dst->damage_full = true;
+	dst->readback_full = true;
 
 	static int rendertarget_id;
 	rendertarget_id = (rendertarget_id + 1) % (INT_MAX-1);
 	dst->id = rendertarget_id;
+	dst->attach_key = attach_key();
 
 	vobj->extrefc.attachments++;
 	trace("(setuprendertarget), (%d:%s) defined as rendertarget."
@@ -2406,6 +2823,9 @@ arcan_errc arcan_video_setasframe(arcan_vobj_id dst,
 	if (fid >= dstvobj->frameset->n_frames)
 		return ARCAN_ERRC_BAD_ARGUMENT;
 
+	if (!arcan_vint_atlas_evict(srcvobj))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 	struct frameset_store* store = &dstvobj->frameset->frames[fid];
 	if (store->frame != srcvobj->vstore){
 		arcan_vint_drop_vstore(store->frame);
@@ -2424,66 +2844,276 @@ arcan_errc arcan_video_setasframe(arcan_vobj_id dst,
 	return ARCAN_OK;
 }
 
+enum asynch_state {
+	ASYNCH_QUEUED = 0,
+	ASYNCH_RUNNING,
+	ASYNCH_DONE
+};
+
 struct thread_loader_args {
 	arcan_vobject* dst;
-	pthread_t self;
 	arcan_vobj_id dstid;
 	char* fname;
 	intptr_t tag;
 	img_cons constraints;
 	arcan_errc rc;
+
+/* pool bookkeeping, protected by asynch_pool.lock except for [prio] which
+ * is only ever touched from the main thread */
+	enum asynch_state state;
+	bool prio;
+	unsigned long long enqueued;
+	struct thread_loader_args* next;
+	struct thread_loader_args* prev;
+};
+
+/*
+ * Persistent pool of loader threads that are spawned on demand (up to
+ * ASYNCH_CONCURRENT_THREADS) and then kept around. Jobs for objects that have
+ * become visible are moved to the priority queue, and jobs that haven't
+ * started yet are dropped if the object is deleted.
+ */
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t work;
+	pthread_cond_t done;
+
+	struct {
+		struct thread_loader_args* first;
+		struct thread_loader_args* last;
+	} queue[2];
+
+	struct arcan_video_asynchstats stats;
+	unsigned long long latency_sum;
+} asynch_pool = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.work = PTHREAD_COND_INITIALIZER,
+	.done = PTHREAD_COND_INITIALIZER
 };
 
-static void* thread_loader(void* in)
+static void asynch_unlink(struct thread_loader_args* job)
 {
-	struct thread_loader_args* largs = (struct thread_loader_args*) in;
-	arcan_vobject* dst = largs->dst;
-	largs->rc = arcan_vint_getimage(largs->fname, dst, largs->constraints, true);
-	dst->feed.state.tag = ARCAN_TAG_ASYNCIMGRD;
-	return 0;
+	int qi = job->prio ? 1 : 0;
+
+	if (job->prev)
+		job->prev->next = job->next;
+	else
+		asynch_pool.queue[qi].first = job->next;
+
+	if (job->next)
+		job->next->prev = job->prev;
+	else
+		asynch_pool.queue[qi].last = job->prev;
+
+	job->next = job->prev = NULL;
+	asynch_pool.stats.queued--;
+	if (job->prio)
+		asynch_pool.stats.queued_prio--;
 }
 
-void arcan_vint_joinasynch(arcan_vobject* img, bool emit, bool force)
+static void asynch_link(struct thread_loader_args* job)
 {
-	if (!force && img->feed.state.tag != ARCAN_TAG_ASYNCIMGRD){
-		return;
-	}
+	int qi = job->prio ? 1 : 0;
 
-	struct thread_loader_args* args =
-		(struct thread_loader_args*) img->feed.state.ptr;
+	job->next = NULL;
+	job->prev = asynch_pool.queue[qi].last;
 
-	pthread_join(args->self, NULL);
+	if (job->prev)
+		job->prev->next = job;
+	else
+		asynch_pool.queue[qi].first = job;
 
-	arcan_event loadev = {
-		.category = EVENT_VIDEO,
-		.vid.data = args->tag,
-		.vid.source = args->dstid
-	};
+	asynch_pool.queue[qi].last = job;
+	asynch_pool.stats.queued++;
+	if (job->prio)
+		asynch_pool.stats.queued_prio++;
+}
 
-	if (args->rc == ARCAN_OK){
-		loadev.vid.kind = EVENT_VIDEO_ASYNCHIMAGE_LOADED;
-		loadev.vid.width = img->origw;
-		loadev.vid.height = img->origh;
-	}
-/* copy broken placeholder instead */
-	else {
-		img->origw = 32;
-		img->origh = 32;
-		img->vstore->vinf.text.s_raw = 32 * 32 * sizeof(av_pixel);
-		img->vstore->vinf.text.raw = arcan_alloc_mem(img->vstore->vinf.text.s_raw,
-			ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_PAGE);
+/* assumes asynch_pool.lock is held */
+static void asynch_complete(struct thread_loader_args* job)
+{
+	unsigned long long now = arcan_timemillis();
+	unsigned long long dt = now > job->enqueued ? now - job->enqueued : 0;
 
-		img->vstore->w = 32;
-		img->vstore->h = 32;
-		img->vstore->vinf.text.source = strdup(args->fname);
-		img->vstore->filtermode = ARCAN_VFILTER_NONE;
+	job->state = ASYNCH_DONE;
+	job->dst->feed.state.tag = ARCAN_TAG_ASYNCIMGRD;
 
-		loadev.vid.width = 32;
-		loadev.vid.height = 32;
-		loadev.vid.kind = EVENT_VIDEO_ASYNCHIMAGE_FAILED;
-	}
+	asynch_pool.stats.completed++;
+	asynch_pool.latency_sum += dt;
+	asynch_pool.stats.latency_avg =
+		asynch_pool.latency_sum / asynch_pool.stats.completed;
+	if (dt > asynch_pool.stats.latency_max)
+		asynch_pool.stats.latency_max = dt;
 
-	agp_update_vstore(img->vstore, true);
+	pthread_cond_broadcast(&asynch_pool.done);
+}
+
+static void* asynch_worker(void* in)
+{
+	pthread_mutex_lock(&asynch_pool.lock);
+
+	for(;;){
+		struct thread_loader_args* job = asynch_pool.queue[1].first;
+		if (!job)
+			job = asynch_pool.queue[0].first;
+
+		if (!job){
+			pthread_cond_wait(&asynch_pool.work, &asynch_pool.lock);
+			continue;
+		}
+
+		asynch_unlink(job);
+		job->state = ASYNCH_RUNNING;
+		asynch_pool.stats.running++;
+		pthread_mutex_unlock(&asynch_pool.lock);
+
+		job->rc = arcan_vint_getimage(job->fname, job->dst, job->constraints, true);
+
+/* wake the main thread through the cross-thread event queue rather than
+ * having it wait for the next tick, if the queue is full the tick join still
+ * covers it */
+		arcan_event ready = {
+			.category = EVENT_VIDEO,
+			.vid.kind = EVENT_VIDEO_ASYNCHIMAGE_READY,
+			.vid.source = job->dstid
+		};
+
+		pthread_mutex_lock(&asynch_pool.lock);
+		asynch_pool.stats.running--;
+		asynch_complete(job);
+		pthread_mutex_unlock(&asynch_pool.lock);
+
+		arcan_event_enqueue(arcan_event_defaultctx(), &ready);
+		pthread_mutex_lock(&asynch_pool.lock);
+	}
+
+	return NULL;
+}
+
+/*
+ * Make sure the job backing [img] has finished, if it is still queued it gets
+ * pulled out and run on the calling thread instead of waiting for a worker.
+ */
+static void asynch_wait(arcan_vobject* img)
+{
+	struct thread_loader_args* args =
+		(struct thread_loader_args*) img->feed.state.ptr;
+
+	pthread_mutex_lock(&asynch_pool.lock);
+	if (args->state == ASYNCH_QUEUED){
+		asynch_unlink(args);
+		args->state = ASYNCH_RUNNING;
+		pthread_mutex_unlock(&asynch_pool.lock);
+
+		args->rc = arcan_vint_getimage(
+			args->fname, args->dst, args->constraints, true);
+
+		pthread_mutex_lock(&asynch_pool.lock);
+		asynch_complete(args);
+	}
+
+	while (args->state != ASYNCH_DONE)
+		pthread_cond_wait(&asynch_pool.done, &asynch_pool.lock);
+
+	pthread_mutex_unlock(&asynch_pool.lock);
+}
+
+/*
+ * Move the job for a now visible object ahead of those still hidden.
+ */
+static void asynch_prioritize(arcan_vobject* img)
+{
+	struct thread_loader_args* args =
+		(struct thread_loader_args*) img->feed.state.ptr;
+
+	if (!args || args->prio)
+		return;
+
+	pthread_mutex_lock(&asynch_pool.lock);
+	if (args->state == ASYNCH_QUEUED){
+		asynch_unlink(args);
+		args->prio = true;
+		asynch_link(args);
+	}
+	else
+		args->prio = true;
+	pthread_mutex_unlock(&asynch_pool.lock);
+}
+
+/*
+ * The object is being deleted, drop the job if no worker has picked it up,
+ * otherwise wait for it to finish so the store can be released normally.
+ */
+static void asynch_cancel(arcan_vobject* img)
+{
+	struct thread_loader_args* args =
+		(struct thread_loader_args*) img->feed.state.ptr;
+
+	pthread_mutex_lock(&asynch_pool.lock);
+	if (args->state != ASYNCH_QUEUED){
+		pthread_mutex_unlock(&asynch_pool.lock);
+		arcan_vint_joinasynch(img, false, true);
+		return;
+	}
+
+	asynch_unlink(args);
+	asynch_pool.stats.cancelled++;
+	pthread_mutex_unlock(&asynch_pool.lock);
+
+	arcan_mem_free(args->fname);
+	arcan_mem_free(args);
+	img->feed.state.ptr = NULL;
+	img->feed.state.tag = ARCAN_TAG_IMAGE;
+}
+
+void arcan_video_asynchstats(struct arcan_video_asynchstats* out)
+{
+	pthread_mutex_lock(&asynch_pool.lock);
+	*out = asynch_pool.stats;
+	pthread_mutex_unlock(&asynch_pool.lock);
+}
+
+void arcan_vint_joinasynch(arcan_vobject* img, bool emit, bool force)
+{
+	if (!force && img->feed.state.tag != ARCAN_TAG_ASYNCIMGRD){
+		return;
+	}
+
+	struct thread_loader_args* args =
+		(struct thread_loader_args*) img->feed.state.ptr;
+
+	asynch_wait(img);
+
+	arcan_event loadev = {
+		.category = EVENT_VIDEO,
+		.vid.data = args->tag,
+		.vid.source = args->dstid
+	};
+
+	if (args->rc == ARCAN_OK){
+		loadev.vid.kind = EVENT_VIDEO_ASYNCHIMAGE_LOADED;
+		loadev.vid.width = img->origw;
+		loadev.vid.height = img->origh;
+	}
+/* copy broken placeholder instead */
+	else {
+		img->origw = 32;
+		img->origh = 32;
+		img->vstore->vinf.text.s_raw = 32 * 32 * sizeof(av_pixel);
+		img->vstore->vinf.text.raw = arcan_alloc_mem(img->vstore->vinf.text.s_raw,
+			ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_PAGE);
+
+		img->vstore->w = 32;
+		img->vstore->h = 32;
+		img->vstore->vinf.text.source = strdup(args->fname);
+		img->vstore->filtermode = ARCAN_VFILTER_NONE;
+
+		loadev.vid.width = 32;
+		loadev.vid.height = 32;
+		loadev.vid.kind = EVENT_VIDEO_ASYNCHIMAGE_FAILED;
+	}
+
+	agp_update_vstore(img->vstore, true);
 
 	if (emit)
 		arcan_event_enqueue(arcan_event_defaultctx(), &loadev);
@@ -2494,6 +3124,19 @@ void arcan_vint_joinasynch(arcan_vobject* img, bool emit, bool force)
 	img->feed.state.tag = ARCAN_TAG_IMAGE;
 }
 
+void arcan_video_joinasynch(arcan_vobj_id id)
+{
+	arcan_vobject* vobj = arcan_video_getobject(id);
+	if (!vobj || arcan_conductor_gpus_locked())
+		return;
+
+/* same rule as the tick, the upload waits for an attachment */
+	if (vobj->extrefc.lists <= 0)
+		return;
+
+	arcan_vint_joinasynch(vobj, true, false);
+}
+
 static arcan_vobj_id loadimage_asynch(const char* fname,
 	img_cons constraints, intptr_t tag)
 {
@@ -2504,18 +3147,43 @@ static arcan_vobj_id loadimage_asynch(const char* fname,
 
 	struct thread_loader_args* args = arcan_alloc_mem(
 		sizeof(struct thread_loader_args),
-		ARCAN_MEM_THREADCTX, 0, ARCAN_MEMALIGN_NATURAL);
+		ARCAN_MEM_THREADCTX, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
 
 	args->dstid = rv;
 	args->dst = dstobj;
 	args->fname = strdup(fname);
 	args->tag = tag;
 	args->constraints = constraints;
+	args->enqueued = arcan_timemillis();
 
 	dstobj->feed.state.tag = ARCAN_TAG_ASYNCIMGLD;
 	dstobj->feed.state.ptr = args;
+	tick_track(current_context, dstobj);
+
+	pthread_mutex_lock(&asynch_pool.lock);
+	asynch_link(args);
 
-	pthread_create(&args->self, NULL, thread_loader, (void*) args);
+/* grow the pool while there is more pending work than idle workers */
+	struct arcan_video_asynchstats* st = &asynch_pool.stats;
+	if (st->workers < ASYNCH_CONCURRENT_THREADS &&
+		st->workers < st->queued + st->running){
+		pthread_t pth;
+		pthread_attr_t pthattr;
+		pthread_attr_init(&pthattr);
+		pthread_attr_setdetachstate(&pthattr, PTHREAD_CREATE_DETACHED);
+
+		if (0 == pthread_create(&pth, &pthattr, asynch_worker, NULL))
+			st->workers++;
+
+		pthread_attr_destroy(&pthattr);
+	}
+
+/* no workers at all, degrade to completing on join */
+	if (!st->workers)
+		arcan_warning("loadimage_asynch(), couldn't spawn loader thread\n");
+
+	pthread_cond_signal(&asynch_pool.work);
+	pthread_mutex_unlock(&asynch_pool.lock);
 
 	return rv;
 }
@@ -2578,8 +3246,12 @@ arcan_errc arcan_video_alterfeed(arcan_vobj_id id,
 	if (!vobj)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	if (!arcan_vint_atlas_evict(vobj))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 	vobj->feed.state = state;
 	vobj->feed.ffunc = cb;
+	tick_track(current_context, vobj);
 
 	return ARCAN_OK;
 }
@@ -2626,6 +3298,7 @@ static arcan_vobj_id arcan_video_setupfeed(
 		ARCAN_MEM_VBUFFER, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_PAGE);
 
 	newvobj->feed.ffunc = ffunc;
+	tick_track(current_context, newvobj);
 	agp_update_vstore(newvobj->vstore, true);
 
 	return rv;
@@ -2643,6 +3316,9 @@ arcan_errc arcan_video_resizefeed(arcan_vobj_id id, size_t w, size_t h)
 		vobj->feed.state.tag == ARCAN_TAG_ASYNCIMGRD)
 		arcan_video_pushasynch(id);
 
+	if (!arcan_vint_atlas_evict(vobj))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 /* rescale transformation chain */
 	float ox = (float)vobj->origw*vobj->current.scale.x;
 	float oy = (float)vobj->origh*vobj->current.scale.y;
@@ -2740,6 +3416,21 @@ arcan_errc arcan_video_scaletxcos(arcan_vobj_id id, float sfs, float sft)
 		arcan_vint_defaultmapping(vobj->txcos, 1.0, 1.0);
 	}
 
+	if (vobj->atlas){
+		float txcos[8];
+		memcpy(txcos, arcan_vint_atlas_txcos(vobj), sizeof(float) * 8);
+		for (size_t i = 0; i < 8; i += 2){
+			txcos[i + 0] *= sfs;
+			txcos[i + 1] *= sft;
+		}
+
+		if (arcan_vint_atlas_mapping(vobj, txcos))
+			return ARCAN_OK;
+
+		if (!arcan_vint_atlas_evict(vobj))
+			return ARCAN_ERRC_OUT_OF_SPACE;
+	}
+
 	vobj->txcos[0] *= sfs;
 	vobj->txcos[1] *= sft;
 	vobj->txcos[2] *= sfs;
@@ -2861,6 +3552,7 @@ arcan_errc arcan_video_setlife(arcan_vobj_id id, unsigned lifetime)
 			vobj->mask |= MASK_LIVING;
 
 		vobj->lifetime = lifetime;
+		tick_track(current_context, vobj);
 		rv = ARCAN_OK;
 	}
 
@@ -2922,7 +3614,7 @@ arcan_errc arcan_video_zaptransform(
 				*last = current->next;
 
 			surface_transform* next = current->next;
-			arcan_mem_free(current);
+			transform_free(current);
 			current = next;
 		}
 		else {
@@ -3088,7 +3780,7 @@ arcan_errc arcan_video_instanttransform(
 
 			surface_transform* tokill = current;
 			current = current->next;
-			arcan_mem_free(tokill);
+			transform_free(tokill);
 		}
 		else {
 			last = &current->next;
@@ -3107,6 +3799,9 @@ arcan_errc arcan_video_objecttexmode(arcan_vobj_id id,
 	arcan_errc rv = ARCAN_ERRC_NO_SUCH_OBJECT;
 
 	if (src){
+		if (!arcan_vint_atlas_evict(src))
+			return ARCAN_ERRC_OUT_OF_SPACE;
+
 		src->vstore->txu = modes;
 		src->vstore->txv = modet;
 		agp_update_vstore(src->vstore, false);
@@ -3124,6 +3819,9 @@ arcan_errc arcan_video_objectfilter(arcan_vobj_id id,
 
 /* fake an upload with disabled filteroptions */
 	if (src){
+		if (!arcan_vint_atlas_evict(src))
+			return ARCAN_ERRC_OUT_OF_SPACE;
+
 		src->vstore->filtermode = mode;
 		agp_update_vstore(src->vstore, false);
 	}
@@ -3191,6 +3889,7 @@ arcan_errc arcan_video_copytransform(arcan_vobj_id sid, arcan_vobj_id did)
 
 	arcan_video_zaptransform(did, 0, NULL);
 	dst->transform = dup_chain(src->transform);
+	tick_track(current_context, dst);
 	update_zv(dst, src->order);
 
 	invalidate_cache(dst);
@@ -3261,17 +3960,12 @@ static void drop_rtarget(arcan_vobject* vobj)
 
 	unsigned dstind;
 
-/* linear search for the vobj among rendertargets */
-	for (dstind = 0; dstind < current_context->n_rtargets; dstind++){
-		if (current_context->rtargets[dstind].color == vobj){
-			dst = &current_context->rtargets[dstind];
-			break;
-		}
-	}
-
-	if (!dst)
+	dst = arcan_vint_findrt(vobj);
+	if (!dst || dst == &current_context->stdoutp)
 		return;
 
+	dstind = dst - current_context->rtargets;
+
 /* make sure to drop references from any linktarget */
 	for (size_t i = 0; i < current_context->n_rtargets; i++){
 		if (i == dstind)
@@ -3332,6 +4026,7 @@ static void drop_rtarget(arcan_vobject* vobj)
 		}
 
 /* cleanup and unlink before moving on */
+		attach_index_remove(dst, base);
 		arcan_vobject_litem* last = current;
 		current->elem = (arcan_vobject*) 0xfacefeed;
 		current = current->next;
@@ -3348,6 +4043,7 @@ static void drop_rtarget(arcan_vobject* vobj)
 /* always kill the last element */
 	memset(&current_context->rtargets[RENDERTARGET_LIMIT- 1], 0,
 		sizeof(struct rendertarget));
+	rtgt_reindex(current_context);
 
 /* self-reference gone */
 	vobj->extrefc.attachments--;
@@ -3484,10 +4180,12 @@ arcan_errc arcan_video_deleteobject(arcan_vobj_id id)
 		vobj->feed.state.tag = ARCAN_TAG_NONE;
 	}
 
-	if (vobj->feed.state.tag == ARCAN_TAG_ASYNCIMGLD)
-		arcan_video_pushasynch(id);
+	if (vobj->feed.state.tag == ARCAN_TAG_ASYNCIMGLD ||
+		vobj->feed.state.tag == ARCAN_TAG_ASYNCIMGRD)
+		asynch_cancel(vobj);
 
 /* video storage, will take care of refcounting in case of shared storage */
+	arcan_vint_atlas_release(vobj);
 	arcan_vint_drop_vstore(vobj->vstore);
 	vobj->vstore = NULL;
 
@@ -3529,6 +4227,16 @@ arcan_errc arcan_video_override_mapping(arcan_vobj_id id, float* newmapping)
 	arcan_errc rv = ARCAN_ERRC_NO_SUCH_OBJECT;
 
 	if (vobj && id > 0){
+/* the atlas region can't be sampled outside of, so fall back to a store
+ * of its own if the new mapping would need that */
+		if (vobj->atlas){
+			if (arcan_vint_atlas_mapping(vobj, newmapping))
+				return ARCAN_OK;
+
+			if (!arcan_vint_atlas_evict(vobj))
+				return ARCAN_ERRC_OUT_OF_SPACE;
+		}
+
 		if (vobj->txcos)
 			arcan_mem_free(vobj->txcos);
 
@@ -3548,8 +4256,10 @@ arcan_errc arcan_video_retrieve_mapping(arcan_vobj_id id, float* dst)
 	arcan_errc rv = ARCAN_ERRC_NO_SUCH_OBJECT;
 
 	if (vobj && dst && id > 0){
-		float* sptr = vobj->txcos ?
+		const float* sptr = vobj->txcos ?
 			vobj->txcos : arcan_video_display.default_txcos;
+		if (vobj->atlas)
+			sptr = arcan_vint_atlas_txcos(vobj);
 		memcpy(dst, sptr, sizeof(float) * 8);
 		rv = ARCAN_OK;
 	}
@@ -3668,15 +4378,15 @@ arcan_errc arcan_video_objectrotate3d(arcan_vobj_id id,
 
 	if (!base){
 		if (last)
-			base = last->next = arcan_alloc_mem(sizeof(surface_transform),
-							ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+			base = last->next = transform_alloc();
 		else
-			base = last = arcan_alloc_mem(sizeof(surface_transform),
-				ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+			base = last = transform_alloc();
 	}
 
-	if (!vobj->transform)
+	if (!vobj->transform){
 		vobj->transform = base;
+		tick_track(current_context, vobj);
+	}
 
 	base->rotate.startt = last->rotate.endt < arcan_video_display.c_ticks ?
 		arcan_video_display.c_ticks : last->rotate.endt;
@@ -3713,6 +4423,9 @@ arcan_errc arcan_video_allocframes(arcan_vobj_id id,
 	if (FL_TEST(target, FL_PRSIST))
 		return ARCAN_ERRC_CLONE_NOT_PERMITTED;
 
+	if (!arcan_vint_atlas_evict(target))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 /* special case, de-allocate */
 	if (capacity <= 1){
 		drop_frameset(target);
@@ -3796,17 +4509,15 @@ arcan_errc arcan_video_objectopacity(arcan_vobj_id id,
 
 			if (!base){
 				if (last)
-					base = last->next =
-						arcan_alloc_mem(sizeof(surface_transform), ARCAN_MEM_VSTRUCT,
-							ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+					base = last->next = transform_alloc();
 				else
-					base = last =
-						arcan_alloc_mem(sizeof(surface_transform), ARCAN_MEM_VSTRUCT,
-							ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+					base = last = transform_alloc();
 			}
 
-			if (!vobj->transform)
+			if (!vobj->transform){
 				vobj->transform = base;
+				tick_track(current_context, vobj);
+			}
 
 			if (vobj->owner)
 				vobj->owner->transfc++;
@@ -3928,19 +4639,17 @@ arcan_errc arcan_video_objectmove(arcan_vobj_id id, float newx,
 
 	if (!base){
 		if (last)
-			base = last->next =
-				arcan_alloc_mem(sizeof(surface_transform), ARCAN_MEM_VSTRUCT,
-					ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+			base = last->next = transform_alloc();
 		else
-			base = last =
-				arcan_alloc_mem(sizeof(surface_transform), ARCAN_MEM_VSTRUCT,
-					ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+			base = last = transform_alloc();
 	}
 
 	point newp = {newx, newy, newz};
 
-	if (!vobj->transform)
+	if (!vobj->transform){
 		vobj->transform = base;
+		tick_track(current_context, vobj);
+	}
 
 	base->move.startt = last->move.endt < arcan_video_display.c_ticks ?
 		arcan_video_display.c_ticks : last->move.endt;
@@ -3993,15 +4702,15 @@ arcan_errc arcan_video_objectscale(arcan_vobj_id id, float wf,
 
 			if (!base){
 				if (last)
-					base = last->next = arcan_alloc_mem(sizeof(surface_transform),
-						ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+					base = last->next = transform_alloc();
 				else
-					base = last = arcan_alloc_mem(sizeof(surface_transform),
-						ARCAN_MEM_VSTRUCT, ARCAN_MEM_BZERO, ARCAN_MEMALIGN_NATURAL);
+					base = last = transform_alloc();
 			}
 
-			if (!vobj->transform)
+			if (!vobj->transform){
 				vobj->transform = base;
+				tick_track(current_context, vobj);
+			}
 
 			base->scale.startt = last->scale.endt < arcan_video_display.c_ticks ?
 				arcan_video_display.c_ticks : last->scale.endt;
@@ -4170,7 +4879,7 @@ static void compact_transformation(arcan_vobject* base,
 	if (!(work->blend.startt | work->scale.startt |
 		work->move.startt | work->rotate.startt )){
 
-		arcan_mem_free(work);
+		transform_free(work);
 		if (last)
 			last->next = NULL;
 		else
@@ -4199,157 +4908,223 @@ static inline float lerp_fract(float startt, float endt, float ts)
 	return rv;
 }
 
-/* This is run for each active rendertarget and once for each object by
- * generating a cookie (stamp) so that objects that exist in multiple
- * rendertargets do not get updated several times.
- *
- * It returns the number of transforms applied to the object. */
-static int update_object(arcan_vobject* ci, unsigned long long stamp)
+/* per-object transformation state produced by interp_object, the lower half
+ * marks the slots that were running and the upper half those that completed */
+enum xfer_slot {
+	XFER_BLEND = 1,
+	XFER_MOVE = 2,
+	XFER_SCALE = 4,
+	XFER_ROTATE = 8
+};
+#define XFER_DONE(X) ((X) << 4)
+
+static int xfer_count(uint8_t state)
 {
-	int upd = 0;
+	return !!(state & XFER_BLEND) + !!(state & XFER_MOVE) +
+		!!(state & XFER_SCALE) + !!(state & XFER_ROTATE);
+}
 
-/* update parent if this has not already been updated this cycle */
-	if (ci->last_updated < stamp &&
-		ci->parent && ci->parent != &current_context->world &&
-		ci->parent->last_updated != stamp){
-		upd += update_object(ci->parent, stamp);
-	}
+/*
+ * Step the interpolated properties of a single object. This only touches
+ * ci->current and is safe to run for different objects in parallel, anything
+ * with side effects (events, cycling, chain compaction) is left for
+ * complete_object.
+ */
+static uint8_t interp_object(arcan_vobject* ci, unsigned long long stamp)
+{
+	surface_transform* tf = ci->transform;
+	uint8_t state = 0;
 
-	ci->last_updated = stamp;
+	if (!tf)
+		return 0;
 
-	if (!ci->transform)
-		return upd;
+	if (tf->blend.startt){
+		state |= XFER_BLEND;
+		float fract = lerp_fract(tf->blend.startt, tf->blend.endt, stamp);
 
-	if (ci->transform->blend.startt){
-		upd++;
-		float fract = lerp_fract(ci->transform->blend.startt,
-			ci->transform->blend.endt, stamp);
+		if (fract > 1.0-EPSILON){
+			ci->current.opa = tf->blend.endopa;
+			state |= XFER_DONE(XFER_BLEND);
+		}
+		else
+			ci->current.opa = lut_interp_1d[tf->blend.interp](
+				tf->blend.startopa, tf->blend.endopa, fract);
+	}
 
-		ci->current.opa = lut_interp_1d[ci->transform->blend.interp](
-			ci->transform->blend.startopa,
-			ci->transform->blend.endopa, fract
-		);
+	if (tf->move.startt){
+		state |= XFER_MOVE;
+		float fract = lerp_fract(tf->move.startt, tf->move.endt, stamp);
 
 		if (fract > 1.0-EPSILON){
-			ci->current.opa = ci->transform->blend.endopa;
-
-			if (FL_TEST(ci, FL_TCYCLE)){
-				arcan_video_objectopacity(ci->cellid, ci->transform->blend.endopa,
-					ci->transform->blend.endt - ci->transform->blend.startt);
-				if (ci->transform->blend.interp > 0)
-					arcan_video_blendinterp(ci->cellid, ci->transform->blend.interp);
-			}
+			ci->current.position = tf->move.endp;
+			state |= XFER_DONE(XFER_MOVE);
+		}
+		else
+			ci->current.position = lut_interp_3d[tf->move.interp](
+				tf->move.startp, tf->move.endp, fract);
+	}
 
-			if (ci->transform->blend.tag)
-				emit_transform_event(ci->cellid,
-					MASK_OPACITY, ci->transform->blend.tag);
+	if (tf->scale.startt){
+		state |= XFER_SCALE;
+		float fract = lerp_fract(tf->scale.startt, tf->scale.endt, stamp);
 
-			compact_transformation(ci,
-				offsetof(surface_transform, blend),
-				sizeof(struct transf_blend));
+		if (fract > 1.0-EPSILON){
+			ci->current.scale = tf->scale.endd;
+			state |= XFER_DONE(XFER_SCALE);
 		}
+		else
+			ci->current.scale = lut_interp_3d[tf->scale.interp](
+				tf->scale.startd, tf->scale.endd, fract);
 	}
 
-	if (ci->transform && ci->transform->move.startt){
-		upd++;
-		float fract = lerp_fract(ci->transform->move.startt,
-			ci->transform->move.endt, stamp);
-
-		ci->current.position = lut_interp_3d[ci->transform->move.interp](
-				ci->transform->move.startp,
-				ci->transform->move.endp, fract
-			);
+	if (tf->rotate.startt){
+		state |= XFER_ROTATE;
+		float fract = lerp_fract(tf->rotate.startt, tf->rotate.endt, stamp);
 
+/* close enough */
 		if (fract > 1.0-EPSILON){
-			ci->current.position = ci->transform->move.endp;
-
-			if (FL_TEST(ci, FL_TCYCLE)){
-				arcan_video_objectmove(ci->cellid,
-					ci->transform->move.endp.x,
-					ci->transform->move.endp.y,
-					ci->transform->move.endp.z,
-					ci->transform->move.endt - ci->transform->move.startt
-				);
-
-				if (ci->transform->move.interp > 0)
-					arcan_video_moveinterp(ci->cellid, ci->transform->move.interp);
-			}
+			ci->current.rotation = tf->rotate.endo;
+			state |= XFER_DONE(XFER_ROTATE);
+		}
+		else
+			ci->current.rotation.quaternion = tf->rotate.interp(
+				tf->rotate.starto.quaternion, tf->rotate.endo.quaternion, fract);
+	}
+
+	return state;
+}
 
-			if (ci->transform->move.tag)
-				emit_transform_event(ci->cellid,
-					MASK_POSITION, ci->transform->move.tag);
+/*
+ * [state] can be stale by the time it is acted on: an earlier entry in the
+ * same pass can reach Lua-visible state (feed functions, cycling) and zap or
+ * requeue the chain, or the cellid can have been recycled. Re-check that the
+ * current head of the slot is still one that has run its course at [stamp],
+ * completion then also (re-)applies the end state of that head.
+ */
+static bool xfer_due(float startt, float endt, unsigned long long stamp)
+{
+	return startt && lerp_fract(startt, endt, stamp) > 1.0-EPSILON;
+}
+
+/*
+ * Main thread part of the transformation update, for every slot that
+ * completed in [state]: re-queue if the object is cycling, emit the tagged
+ * completion event and pop the slot from the chain.
+ */
+static void complete_object(
+	arcan_vobject* ci, uint8_t state, unsigned long long stamp)
+{
+	if (!FL_TEST(ci, FL_INUSE))
+		return;
 
-			compact_transformation(ci,
-				offsetof(surface_transform, move),
-				sizeof(struct transf_move));
+	if ((state & XFER_DONE(XFER_BLEND)) && ci->transform &&
+		xfer_due(ci->transform->blend.startt, ci->transform->blend.endt, stamp)){
+		ci->current.opa = ci->transform->blend.endopa;
+		if (FL_TEST(ci, FL_TCYCLE)){
+			arcan_video_objectopacity(ci->cellid, ci->transform->blend.endopa,
+				ci->transform->blend.endt - ci->transform->blend.startt);
+			if (ci->transform->blend.interp > 0)
+				arcan_video_blendinterp(ci->cellid, ci->transform->blend.interp);
 		}
+
+		if (ci->transform->blend.tag)
+			emit_transform_event(ci->cellid,
+				MASK_OPACITY, ci->transform->blend.tag);
+
+		compact_transformation(ci,
+			offsetof(surface_transform, blend),
+			sizeof(struct transf_blend));
 	}
 
-	if (ci->transform && ci->transform->scale.startt){
-		upd++;
-		float fract = lerp_fract(ci->transform->scale.startt,
-			ci->transform->scale.endt, stamp);
-		ci->current.scale = lut_interp_3d[ci->transform->scale.interp](
-			ci->transform->scale.startd,
-			ci->transform->scale.endd, fract
-		);
+	if ((state & XFER_DONE(XFER_MOVE)) && ci->transform &&
+		xfer_due(ci->transform->move.startt, ci->transform->move.endt, stamp)){
+		ci->current.position = ci->transform->move.endp;
+		if (FL_TEST(ci, FL_TCYCLE)){
+			arcan_video_objectmove(ci->cellid,
+				ci->transform->move.endp.x,
+				ci->transform->move.endp.y,
+				ci->transform->move.endp.z,
+				ci->transform->move.endt - ci->transform->move.startt
+			);
 
-		if (fract > 1.0-EPSILON){
-			ci->current.scale = ci->transform->scale.endd;
+			if (ci->transform->move.interp > 0)
+				arcan_video_moveinterp(ci->cellid, ci->transform->move.interp);
+		}
 
-			if (FL_TEST(ci, FL_TCYCLE)){
-				arcan_video_objectscale(ci->cellid, ci->transform->scale.endd.x,
-					ci->transform->scale.endd.y,
-					ci->transform->scale.endd.z,
-					ci->transform->scale.endt - ci->transform->scale.startt);
+		if (ci->transform->move.tag)
+			emit_transform_event(ci->cellid,
+				MASK_POSITION, ci->transform->move.tag);
 
-				if (ci->transform->scale.interp > 0)
-					arcan_video_scaleinterp(ci->cellid, ci->transform->scale.interp);
-			}
+		compact_transformation(ci,
+			offsetof(surface_transform, move),
+			sizeof(struct transf_move));
+	}
 
-			if (ci->transform->scale.tag)
-				emit_transform_event(ci->cellid, MASK_SCALE, ci->transform->scale.tag);
+	if ((state & XFER_DONE(XFER_SCALE)) && ci->transform &&
+		xfer_due(ci->transform->scale.startt, ci->transform->scale.endt, stamp)){
+		ci->current.scale = ci->transform->scale.endd;
+		if (FL_TEST(ci, FL_TCYCLE)){
+			arcan_video_objectscale(ci->cellid, ci->transform->scale.endd.x,
+				ci->transform->scale.endd.y,
+				ci->transform->scale.endd.z,
+				ci->transform->scale.endt - ci->transform->scale.startt);
 
-			compact_transformation(ci,
-				offsetof(surface_transform, scale),
-				sizeof(struct transf_scale));
+			if (ci->transform->scale.interp > 0)
+				arcan_video_scaleinterp(ci->cellid, ci->transform->scale.interp);
 		}
+
+		if (ci->transform->scale.tag)
+			emit_transform_event(ci->cellid, MASK_SCALE, ci->transform->scale.tag);
+
+		compact_transformation(ci,
+			offsetof(surface_transform, scale),
+			sizeof(struct transf_scale));
 	}
 
-	if (ci->transform && ci->transform->rotate.startt){
-		upd++;
-		float fract = lerp_fract(ci->transform->rotate.startt,
-			ci->transform->rotate.endt, stamp);
+	if ((state & XFER_DONE(XFER_ROTATE)) && ci->transform &&
+		xfer_due(ci->transform->rotate.startt, ci->transform->rotate.endt, stamp)){
+		ci->current.rotation = ci->transform->rotate.endo;
+		if (FL_TEST(ci, FL_TCYCLE))
+			arcan_video_objectrotate3d(ci->cellid,
+				ci->transform->rotate.endo.roll,
+				ci->transform->rotate.endo.pitch,
+				ci->transform->rotate.endo.yaw,
+				ci->transform->rotate.endt - ci->transform->rotate.startt
+			);
 
-/* close enough */
-		if (fract > 1.0-EPSILON){
-			ci->current.rotation = ci->transform->rotate.endo;
-			if (FL_TEST(ci, FL_TCYCLE))
-				arcan_video_objectrotate3d(ci->cellid,
-					ci->transform->rotate.endo.roll,
-					ci->transform->rotate.endo.pitch,
-					ci->transform->rotate.endo.yaw,
-					ci->transform->rotate.endt - ci->transform->rotate.startt
-				);
-
-			if (ci->transform->rotate.tag)
-				emit_transform_event(ci->cellid,
-					MASK_ORIENTATION, ci->transform->rotate.tag);
-
-			compact_transformation(ci,
-				offsetof(surface_transform, rotate),
-				sizeof(struct transf_rotate));
-		}
-		else {
-			ci->current.rotation.quaternion =
-				ci->transform->rotate.interp(
-					ci->transform->rotate.starto.quaternion,
-					ci->transform->rotate.endo.quaternion, fract
-				);
-		}
+		if (ci->transform->rotate.tag)
+			emit_transform_event(ci->cellid,
+				MASK_ORIENTATION, ci->transform->rotate.tag);
+
+		compact_transformation(ci,
+			offsetof(surface_transform, rotate),
+			sizeof(struct transf_rotate));
 	}
+}
 
-	return upd;
+/* Serial version of the transformation update, the cookie (stamp) prevents
+ * parents that are reached through their children from being updated several
+ * times. The tick itself goes through interp_object / complete_object on the
+ * tickset instead.
+ *
+ * It returns the number of transforms applied to the object. */
+static int update_object(arcan_vobject* ci, unsigned long long stamp)
+{
+	int upd = 0;
+
+/* update parent if this has not already been updated this cycle */
+	if (ci->last_updated < stamp &&
+		ci->parent && ci->parent != &current_context->world &&
+		ci->parent->last_updated != stamp){
+		upd += update_object(ci->parent, stamp);
+	}
+
+	ci->last_updated = stamp;
+
+	uint8_t state = interp_object(ci, stamp);
+	complete_object(ci, state, stamp);
+
+	return upd + xfer_count(state);
 }
 
 static void expire_object(arcan_vobject* obj){
@@ -4416,49 +5191,319 @@ static inline void process_readback(struct rendertarget* tgt, float fract)
 		}
 
 /* check again as the ffunc might av unset the hwreadback flag */
-		if (!tgt->hwreadback){
-			agp_request_readback(tgt->color->vstore);
-			FL_SET(tgt, TGTFL_READING);
-		}
+		if (!tgt->hwreadback)
+			arcan_vint_requestreadback(tgt);
 	}
 }
 
+void arcan_vint_requestreadback(struct rendertarget* tgt)
+{
+	if (tgt->readback_full)
+		agp_request_readback(tgt->color->vstore);
+	else
+		agp_request_readback_region(tgt->color->vstore, &tgt->readback_damage);
+
+	tgt->readback_damage = (struct agp_region){0};
+	tgt->readback_full = false;
+	FL_SET(tgt, TGTFL_READING);
+}
+
 /*
- * return number of actual objects that were updated / dirty,
- * move/process/etc. and possibly dispatch draw commands if needed
+ * Pool for the interpolation pass of the tick. Workers are spawned the first
+ * time the tickset is large enough, then sleep on [work] until the generation
+ * changes. Entries are handed out in chunks through [cursor] so that threads
+ * that finish early keep pulling from the same range rather than idling on a
+ * static split, the main thread takes part as well. [stop] is set on video
+ * shutdown, which then joins the workers.
  */
-static int tick_rendertarget(struct rendertarget* tgt)
-{
-	tgt->transfc = 0;
-	arcan_vobject_litem* current = tgt->first;
+static struct {
+	pthread_mutex_t lock;
+	pthread_cond_t work;
+	pthread_cond_t done;
+
+	bool spawned;
+	bool stop;
+	unsigned workers;
+	pthread_t threads[TICK_CONCURRENT_THREADS + 1];
+	unsigned busy;
+	unsigned long long gen;
+
+	struct arcan_video_context* ctx;
+	unsigned long long stamp;
+	size_t count;
+	atomic_size_t cursor;
+} tick_pool = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.work = PTHREAD_COND_INITIALIZER,
+	.done = PTHREAD_COND_INITIALIZER
+};
 
-	while (current){
-		arcan_vobject* elem = current->elem;
+static void tick_interp_entries(struct arcan_video_context* ctx,
+	size_t ofs, size_t end, unsigned long long stamp)
+{
+	struct vobject_tickset* ts = &ctx->ticks;
 
-		arcan_vint_joinasynch(elem, true, false);
+	for (size_t i = ofs; i < end; i++){
+		ts->xfer[i] = 0;
+		if (!(ts->work[i] & TICK_TRANSFORM))
+			continue;
 
-		if (elem->last_updated != arcan_video_display.c_ticks)
-			tgt->transfc += update_object(elem, arcan_video_display.c_ticks);
+/* detached objects only advance when reached through an attached child */
+		arcan_vobject* elem = &ctx->vitems_pool[ts->id[i]];
+		if (!FL_TEST(elem, FL_INUSE) ||
+			elem->last_updated == stamp || !elem->extrefc.lists)
+			continue;
 
-		if (elem->feed.ffunc)
-			arcan_ffunc_lookup(elem->feed.ffunc)
-				(FFUNC_TICK, 0, 0, 0, 0, 0, elem->feed.state, elem->cellid);
+		elem->last_updated = stamp;
+		ts->xfer[i] = interp_object(elem, stamp);
+	}
+}
+
+static void tick_interp_range(
+	struct arcan_video_context* ctx, size_t count, unsigned long long stamp)
+{
+	for(;;){
+		size_t ofs = atomic_fetch_add(&tick_pool.cursor, TICK_PARALLEL_CHUNK);
+		if (ofs >= count)
+			return;
+
+		size_t end = ofs + TICK_PARALLEL_CHUNK;
+		tick_interp_entries(ctx, ofs, end > count ? count : end, stamp);
+	}
+}
+
+static void* tick_worker(void* in)
+{
+	unsigned long long gen = 0;
+	pthread_mutex_lock(&tick_pool.lock);
+
+	for(;;){
+		if (tick_pool.stop)
+			break;
+
+		if (tick_pool.gen == gen){
+			pthread_cond_wait(&tick_pool.work, &tick_pool.lock);
+			continue;
+		}
+
+		gen = tick_pool.gen;
+		struct arcan_video_context* ctx = tick_pool.ctx;
+		size_t count = tick_pool.count;
+		unsigned long long stamp = tick_pool.stamp;
+		tick_pool.busy++;
+		pthread_mutex_unlock(&tick_pool.lock);
+
+		tick_interp_range(ctx, count, stamp);
+
+		pthread_mutex_lock(&tick_pool.lock);
+		if (--tick_pool.busy == 0)
+			pthread_cond_signal(&tick_pool.done);
+	}
+
+	pthread_mutex_unlock(&tick_pool.lock);
+	return NULL;
+}
+
+static void tick_pool_stop()
+{
+	pthread_mutex_lock(&tick_pool.lock);
+	tick_pool.stop = true;
+	pthread_cond_broadcast(&tick_pool.work);
+	pthread_mutex_unlock(&tick_pool.lock);
+
+	for (size_t i = 0; i < tick_pool.workers; i++)
+		pthread_join(tick_pool.threads[i], NULL);
+
+/* allow a later video_init to spawn a new set */
+	tick_pool.workers = 0;
+	tick_pool.spawned = false;
+	tick_pool.stop = false;
+}
+
+static void tick_interp(
+	struct arcan_video_context* ctx, size_t count, unsigned long long stamp)
+{
+	if (count < TICK_PARALLEL_THRESHOLD || !TICK_CONCURRENT_THREADS){
+		tick_interp_entries(ctx, 0, count, stamp);
+		return;
+	}
+
+/* a worker that woke up too late for the previous pass might still be
+ * draining the old range, wait for it before the cursor gets reset */
+	pthread_mutex_lock(&tick_pool.lock);
+	while (tick_pool.busy)
+		pthread_cond_wait(&tick_pool.done, &tick_pool.lock);
+
+	while (!tick_pool.spawned && tick_pool.workers < TICK_CONCURRENT_THREADS){
+		bool ok = 0 == pthread_create(
+			&tick_pool.threads[tick_pool.workers], NULL, tick_worker, NULL);
+
+/* degrade to whatever we got, the main thread covers the rest */
+		if (!ok){
+			arcan_warning("tick_interp(), couldn't spawn worker thread\n");
+			break;
+		}
+		tick_pool.workers++;
+	}
+	tick_pool.spawned = true;
+
+	atomic_store(&tick_pool.cursor, 0);
+	tick_pool.ctx = ctx;
+	tick_pool.count = count;
+	tick_pool.stamp = stamp;
+	tick_pool.gen++;
+	pthread_cond_broadcast(&tick_pool.work);
+	pthread_mutex_unlock(&tick_pool.lock);
+
+	tick_interp_range(ctx, count, stamp);
+
+/* workers that wake up after this point find the range exhausted */
+	pthread_mutex_lock(&tick_pool.lock);
+	while (tick_pool.busy)
+		pthread_cond_wait(&tick_pool.done, &tick_pool.lock);
+	pthread_mutex_unlock(&tick_pool.lock);
+}
+
+/*
+ * Serial pass for an entry after interpolation, the closest ancestor in the
+ * tickset is completed first so that chain events keep the parent-before-child
+ * order. Ancestors that aren't attached anywhere were skipped by the parallel
+ * pass and are interpolated here instead, like the parent recursion in
+ * update_object.
+ */
+static void tick_complete(struct arcan_video_context* ctx,
+	size_t i, size_t count, unsigned long long stamp, int* upd)
+{
+	struct vobject_tickset* ts = &ctx->ticks;
+	arcan_vobject* elem = &ctx->vitems_pool[ts->id[i]];
+
+	if ((ts->work[i] & TICK_TRANSFORM) &&
+		FL_TEST(elem, FL_INUSE) && elem->last_updated != stamp){
+		elem->last_updated = stamp;
+		ts->xfer[i] = interp_object(elem, stamp);
+	}
+
+	uint8_t state = ts->xfer[i];
+	if (!state)
+		return;
+
+	ts->xfer[i] = 0;
+
+	for (arcan_vobject* cur = elem->parent;
+		cur && cur != &ctx->world; cur = cur->parent){
+		uint32_t pslot = ts->slot[cur->cellid];
+		if (pslot && pslot - 1 < count){
+			tick_complete(ctx, pslot - 1, count, stamp, upd);
+			break;
+		}
+	}
+
+	if (elem->owner)
+		elem->owner->transfc += xfer_count(state);
+	else
+		*upd += xfer_count(state);
+
+	complete_object(elem, state, stamp);
+}
+
+/*
+ * Run the pending work for every object in the tickset. Transformations are
+ * accounted to the rendertarget that owns the object, the return value is the
+ * number of updates for objects without an owner.
+ *
+ * Interpolation has no side effects and is done up front (in parallel when
+ * the set is large), the rest runs here on the main thread in tickset order
+ * so that events reach the Lua side in the same order every time.
+ */
+static int tick_objects(
+	struct arcan_video_context* ctx, unsigned long long stamp)
+{
+	struct vobject_tickset* ts = &ctx->ticks;
+	size_t count = ts->count;
+	int upd = 0;
+
+	tick_interp(ctx, count, stamp);
+
+/* objects that start tracking during the pass get picked up next tick */
+	for (size_t i = 0; i < count; i++){
+		uint8_t work = ts->work[i];
+		if (!work)
+			continue;
+
+		arcan_vobject* elem = &ctx->vitems_pool[ts->id[i]];
+		if (!FL_TEST(elem, FL_INUSE)){
+			ts->work[i] = 0;
+			continue;
+		}
+
+/* detached objects wait for an attachment, their transformations can still
+ * be stepped through tick_complete on an attached child */
+		signed lists = elem->extrefc.lists;
+		if (lists <= 0){
+			ts->work[i] = tick_work(elem);
+			continue;
+		}
+
+		tick_complete(ctx, i, count, stamp, &upd);
+
+		if (work & TICK_ASYNCH){
+			if (elem->feed.state.tag == ARCAN_TAG_ASYNCIMGLD &&
+				elem->current.opa > EPSILON)
+				asynch_prioritize(elem);
+
+			arcan_vint_joinasynch(elem, true, false);
+		}
+
+/* the rest is clocked once for every rendertarget the object is attached to,
+ * the same as when each rendertarget list was walked on its own */
+		for (signed n = 0; n < lists && FL_TEST(elem, FL_INUSE); n++){
+			if ((work & TICK_FFUNC) && elem->feed.ffunc)
+				arcan_ffunc_lookup(elem->feed.ffunc)
+					(FFUNC_TICK, 0, 0, 0, 0, 0, elem->feed.state, elem->cellid);
 
 /* mode > 0, cycle activate frame every 'n' ticks */
-		if (elem->frameset && elem->frameset->mctr != 0){
-			elem->frameset->ctr--;
-			if (elem->frameset->ctr == 0){
-				step_active_frame(elem);
-				elem->frameset->ctr = abs( elem->frameset->mctr );
+			if ((work & TICK_FRAMESET) &&
+				elem->frameset && elem->frameset->mctr != 0){
+				elem->frameset->ctr--;
+				if (elem->frameset->ctr == 0){
+					step_active_frame(elem);
+					elem->frameset->ctr = abs( elem->frameset->mctr );
+				}
 			}
+
+			if ((work & TICK_LIFETIME) && (elem->mask & MASK_LIVING) > 0)
+				expire_object(elem);
 		}
 
-		if ((elem->mask & MASK_LIVING) > 0)
-			expire_object(elem);
+/* the object might have been deleted (zeroed) by the feed function */
+		ts->work[i] = tick_work(elem);
+	}
 
-		current = current->next;
+/* compact, entries that went idle are dropped and their slots released */
+	size_t out = 0;
+	for (size_t i = 0; i < ts->count; i++){
+		if (!ts->work[i]){
+			ts->slot[ts->id[i]] = 0;
+			continue;
+		}
+
+		ts->id[out] = ts->id[i];
+		ts->work[out] = ts->work[i];
+		ts->slot[ts->id[i]] = out + 1;
+		out++;
 	}
+	ts->count = out;
 
+	return upd;
+}
+
+/*
+ * return number of actual objects that were updated / dirty, the objects
+ * themselves have already been stepped by tick_objects, this takes care of
+ * the refresh / readback clocks and possibly dispatch draw commands
+ */
+static int tick_rendertarget(struct rendertarget* tgt)
+{
 	if (tgt->refresh > 0 && process_counter(tgt,
 		&tgt->refreshcnt, tgt->refresh, 0.0)){
 		tgt->transfc += process_rendertarget(tgt, 0.0, false);
@@ -4488,8 +5533,19 @@ unsigned arcan_video_tick(unsigned steps, unsigned* njobs)
 		arcan_video_display.dirty +=
 			update_object(&current_context->world, arcan_video_display.c_ticks);
 
+/* shaders that animate on the timestamp can't be attributed to a region */
+		size_t nts = agp_shader_envv(TIMESTAMP_D, &tsd, sizeof(uint32_t));
+		if (nts){
+			arcan_video_display.dirty += nts;
+			arcan_video_display.damage_gen++;
+		}
+
+		for (size_t i = 0; i < current_context->n_rtargets; i++)
+			current_context->rtargets[i].transfc = 0;
+		current_context->stdoutp.transfc = 0;
+
 		arcan_video_display.dirty +=
-			agp_shader_envv(TIMESTAMP_D, &tsd, sizeof(uint32_t));
+			tick_objects(current_context, arcan_video_display.c_ticks);
 
 		for (size_t i = 0; i < current_context->n_rtargets; i++)
 			arcan_video_display.dirty +=
@@ -4545,6 +5601,9 @@ arcan_errc arcan_video_persistobject(arcan_vobj_id id)
 	if (!vobj)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	if (!arcan_vint_atlas_evict(vobj))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 	if (!vobj->frameset &&
 		vobj->vstore->refcount == 1 &&
 		vobj->parent == &current_context->world){
@@ -4847,15 +5906,13 @@ static void update_shenv(arcan_vobject* src, surface_properties* prop)
 	}
 }
 
-static inline void setup_surf(struct rendertarget* dst,
-	surface_properties* prop, arcan_vobject* src, float** mv)
+/*
+ * Resolve the modelview for drawing [src] into [dst], [prop] is converted to
+ * centerpoint + half-extents. [scratch] is used unless there is a cached one.
+ */
+static inline float* surf_modelview(struct rendertarget* dst,
+	surface_properties* prop, arcan_vobject* src, float* scratch)
 {
-/* just temporary storage/scratch */
-	static float _Alignas(16) dmatr[16];
-
-	if (src->feed.state.tag == ARCAN_TAG_ASYNCIMGLD)
-		return;
-
 /* currently, we only cache the primary rendertarget, and the better option is
  * to actually remove secondary attachments etc. now that we have order-peeling
  * and sharestorage there should really just be 1:1 between src and dst */
@@ -4864,12 +5921,23 @@ static inline void setup_surf(struct rendertarget* dst,
 		prop->scale.y *= src->origh * 0.5f;
 		prop->position.x += prop->scale.x;
 		prop->position.y += prop->scale.y;
-		*mv = src->prop_matr;
-	}
-	else {
-		build_modelview(dmatr, dst->base, prop, src);
-		*mv = dmatr;
+		return src->prop_matr;
 	}
+
+	build_modelview(scratch, dst->base, prop, src);
+	return scratch;
+}
+
+static inline void setup_surf(struct rendertarget* dst,
+	surface_properties* prop, arcan_vobject* src, float** mv)
+{
+/* just temporary storage/scratch */
+	static float _Alignas(16) dmatr[16];
+
+	if (src->feed.state.tag == ARCAN_TAG_ASYNCIMGLD)
+		return;
+
+	*mv = surf_modelview(dst, prop, src, dmatr);
 	update_shenv(src, prop);
 }
 
@@ -5138,30 +6206,173 @@ void arcan_vint_bindmulti(arcan_vobject* elem, size_t ind)
 	agp_activate_vstore_multi(elems, sz);
 }
 
+static inline enum arcan_blendfunc draw_blendmode(
+	arcan_vobject* vobj, surface_properties* dprops)
+{
+	if (vobj->blendmode == BLEND_NORMAL && dprops->opa > 1.0 - EPSILON)
+		return BLEND_NONE;
+	return vobj->blendmode;
+}
+
 static int draw_vobj(struct rendertarget* tgt,
 	arcan_vobject* vobj, surface_properties* dprops, float* txcos)
 {
-	if (vobj->blendmode == BLEND_NORMAL && dprops->opa > 1.0 - EPSILON)
-		agp_blendstate(BLEND_NONE);
-	else
-		agp_blendstate(vobj->blendmode);
+	agp_blendstate(draw_blendmode(vobj, dprops));
 
 /* pick the right vstore drawing type (textured, colored) */
 	struct agp_vstore* vstore = vobj->vstore;
 	if (vstore->txmapped == TXSTATE_OFF && vobj->program != 0){
 		draw_colorsurf(tgt, *dprops, vobj, vstore->vinf.col.r,
 			vstore->vinf.col.g, vstore->vinf.col.b, txcos);
+		tgt->drawc++;
 		return 1;
 	}
 
 	if (vstore->txmapped == TXSTATE_TEX2D){
 		draw_texsurf(tgt, *dprops, vobj, txcos);
+		tgt->drawc++;
 		return 1;
 	}
 
 	return 0;
 }
 
+/*
+ * Consecutive objects that would be drawn with the default shader, the same
+ * store, blend mode and opacity and without anything that needs per-object
+ * state (clipping, meshes, framesets, 3D orientation) are collected here with
+ * their vertices transformed on the CPU and then drawn with one call. The
+ * default shader only reads modelview, projection, opacity and the texture so
+ * the result is the same as drawing them one by one.
+ */
+static struct {
+	agp_shader_id shid;
+	struct agp_vstore* store;
+	enum arcan_blendfunc blend;
+	float opa;
+
+	size_t count;
+	size_t limit;
+	float* verts;
+	float* txcos;
+} draw_batch;
+
+static void draw_batch_flush(struct rendertarget* tgt)
+{
+	if (!draw_batch.count)
+		return;
+
+	agp_shader_activate(draw_batch.shid);
+	agp_shader_envv(OBJ_OPACITY, &draw_batch.opa, sizeof(float));
+	agp_blendstate(draw_batch.blend);
+	agp_activate_vstore(draw_batch.store);
+
+	agp_draw_vobj_batch(draw_batch.verts, draw_batch.txcos, draw_batch.count);
+	tgt->drawc++;
+	tgt->batchc += draw_batch.count;
+	draw_batch.count = 0;
+}
+
+static bool draw_batch_grow()
+{
+	size_t limit = draw_batch.limit ? draw_batch.limit * 2 : 256;
+	float* verts = arcan_alloc_mem(sizeof(float) * 12 * limit,
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_SIMD);
+	float* txcos = arcan_alloc_mem(sizeof(float) * 12 * limit,
+		ARCAN_MEM_VBUFFER, ARCAN_MEM_NONFATAL, ARCAN_MEMALIGN_SIMD);
+
+	if (!verts || !txcos){
+		arcan_mem_free(verts);
+		arcan_mem_free(txcos);
+		return false;
+	}
+
+	if (draw_batch.count){
+		memcpy(verts, draw_batch.verts, sizeof(float) * 12 * draw_batch.count);
+		memcpy(txcos, draw_batch.txcos, sizeof(float) * 12 * draw_batch.count);
+	}
+
+	arcan_mem_free(draw_batch.verts);
+	arcan_mem_free(draw_batch.txcos);
+	draw_batch.verts = verts;
+	draw_batch.txcos = txcos;
+	draw_batch.limit = limit;
+	return true;
+}
+
+/*
+ * Try to add [elem] to the pending batch, flushing it first if the state
+ * differs. Returns false if the object has to go through draw_vobj.
+ */
+static inline bool affine_2d(float* m)
+{
+	return !(fabsf(m[2]) > EPSILON || fabsf(m[6]) > EPSILON ||
+		fabsf(m[14]) > EPSILON || fabsf(m[3]) > EPSILON ||
+		fabsf(m[7]) > EPSILON || fabsf(m[15] - 1.0f) > EPSILON);
+}
+
+static bool draw_batch_add(struct rendertarget* tgt, arcan_vobject* elem,
+	agp_shader_id shid, surface_properties* dprops, float* txcos)
+{
+	if (shid != agp_default_shader(BASIC_2D) ||
+		elem->clip != ARCAN_CLIP_OFF || elem->shape || elem->frameset ||
+		FL_TEST(elem, FL_FULL3D) ||
+		elem->vstore->txmapped != TXSTATE_TEX2D ||
+		elem->feed.state.tag == ARCAN_TAG_ASYNCIMGLD ||
+		fabsf(dprops->rotation.pitch) > EPSILON ||
+		fabsf(dprops->rotation.yaw) > EPSILON)
+		return false;
+
+	float _Alignas(16) scratch[16];
+	surface_properties prop = *dprops;
+	float* m = surf_modelview(tgt, &prop, elem, scratch);
+
+/* only plain 2D affine transforms can be flattened into vertices */
+	if (!affine_2d(m))
+		return false;
+
+	enum arcan_blendfunc blend = draw_blendmode(elem, dprops);
+	if (draw_batch.count && (
+		draw_batch.shid != shid || draw_batch.store != elem->vstore ||
+		draw_batch.blend != blend || draw_batch.opa != dprops->opa))
+		draw_batch_flush(tgt);
+
+	if (draw_batch.count == draw_batch.limit && !draw_batch_grow())
+		return false;
+
+	draw_batch.shid = shid;
+	draw_batch.store = elem->vstore;
+	draw_batch.blend = blend;
+	draw_batch.opa = dprops->opa;
+
+/* same corners and winding as agp_draw_vobj, split into two triangles */
+	float sx = prop.scale.x;
+	float sy = prop.scale.y;
+	float corners[8] = {-sx, -sy, sx, -sy, sx, sy, -sx, sy};
+	float tv[8];
+
+	for (size_t i = 0; i < 4; i++){
+		float x = corners[i * 2 + 0];
+		float y = corners[i * 2 + 1];
+		tv[i * 2 + 0] = m[0] * x + m[4] * y + m[12];
+		tv[i * 2 + 1] = m[1] * x + m[5] * y + m[13];
+	}
+
+	static const uint8_t tri[6] = {0, 1, 2, 0, 2, 3};
+	float* dv = &draw_batch.verts[draw_batch.count * 12];
+	float* dt = &draw_batch.txcos[draw_batch.count * 12];
+
+	for (size_t i = 0; i < 6; i++){
+		dv[i * 2 + 0] = tv[tri[i] * 2 + 0];
+		dv[i * 2 + 1] = tv[tri[i] * 2 + 1];
+		dt[i * 2 + 0] = txcos[tri[i] * 2 + 0];
+		dt[i * 2 + 1] = txcos[tri[i] * 2 + 1];
+	}
+
+	draw_batch.count++;
+	return true;
+}
+
 /*
  * Apply clipping without using the stencil buffer, cheaper but with some
  * caveats of its own. Will work particularly bad for partial clipping with
@@ -5247,6 +6458,461 @@ static inline bool setup_shallow_texclip(
 	return true;
 }
 
+static void region_merge(struct agp_region* d, struct agp_region* r)
+{
+	if (r->x1 >= r->x2 || r->y1 >= r->y2)
+		return;
+
+	if (d->x1 >= d->x2 || d->y1 >= d->y2){
+		*d = *r;
+		return;
+	}
+
+	d->x1 = r->x1 < d->x1 ? r->x1 : d->x1;
+	d->y1 = r->y1 < d->y1 ? r->y1 : d->y1;
+	d->x2 = r->x2 > d->x2 ? r->x2 : d->x2;
+	d->y2 = r->y2 > d->y2 ? r->y2 : d->y2;
+}
+
+static void damage_merge(struct rendertarget* tgt, struct agp_region* r)
+{
+	region_merge(&tgt->damage, r);
+}
+
+/*
+ * Resolve the region of the rendertarget store that [elem] covers when drawn
+ * with [dprops]. Returns false if that can't be determined cheaply (meshes,
+ * rotation around an offset origo) in which case the caller should assume the
+ * entire store to be affected. Vertex stage displacement from custom shaders
+ * is not accounted for.
+ */
+static bool damage_box(struct rendertarget* tgt,
+	arcan_vobject* elem, surface_properties* dprops, struct agp_region* out)
+{
+	if (elem->shape || !tgt->color)
+		return false;
+
+	float w = dprops->scale.x * elem->origw;
+	float h = dprops->scale.y * elem->origh;
+	float x1 = dprops->position.x;
+	float y1 = dprops->position.y;
+	float x2 = x1 + w;
+	float y2 = y1 + h;
+
+	if (x2 < x1){
+		float t = x1; x1 = x2; x2 = t;
+	}
+	if (y2 < y1){
+		float t = y1; y1 = y2; y2 = t;
+	}
+
+/* any rotation fits within the circle around the center */
+	if (fabsf(dprops->rotation.roll) > EPSILON ||
+		fabsf(dprops->rotation.pitch) > EPSILON ||
+		fabsf(dprops->rotation.yaw) > EPSILON){
+		if (fabsf(elem->origo_ofs.x) > EPSILON || fabsf(elem->origo_ofs.y) > EPSILON)
+			return false;
+
+		float cx = 0.5f * (x1 + x2);
+		float cy = 0.5f * (y1 + y2);
+		float r = 0.5f * sqrtf(w * w + h * h);
+		x1 = cx - r;
+		x2 = cx + r;
+		y1 = cy - r;
+		y2 = cy + r;
+	}
+
+/* base carries the rendertarget scale, then the orthographic projection to
+ * normalized device coordinates and from there to the texels of the store,
+ * where row 0 is the first row that a readback returns */
+	float sw = tgt->color->vstore->w;
+	float sh = tgt->color->vstore->h;
+	float* b = tgt->base;
+	float* p = tgt->projection;
+
+	float px[2] = {
+		((p[0] * (b[0] * x1 + b[12]) + p[12]) + 1.0f) * 0.5f * sw,
+		((p[0] * (b[0] * x2 + b[12]) + p[12]) + 1.0f) * 0.5f * sw
+	};
+	float py[2] = {
+		((p[5] * (b[5] * y1 + b[13]) + p[13]) + 1.0f) * 0.5f * sh,
+		((p[5] * (b[5] * y2 + b[13]) + p[13]) + 1.0f) * 0.5f * sh
+	};
+
+	if (px[1] < px[0]){
+		float t = px[0]; px[0] = px[1]; px[1] = t;
+	}
+	if (py[1] < py[0]){
+		float t = py[0]; py[0] = py[1]; py[1] = t;
+	}
+
+/* pad with a texel to account for filtering / rounding at the edges */
+	px[0] = floorf(px[0]) - 1.0f;
+	py[0] = floorf(py[0]) - 1.0f;
+	px[1] = ceilf(px[1]) + 1.0f;
+	py[1] = ceilf(py[1]) + 1.0f;
+
+	*out = (struct agp_region){
+		.x1 = px[0] > 0 ? px[0] : 0,
+		.y1 = py[0] > 0 ? py[0] : 0,
+		.x2 = px[1] > sw ? sw : (px[1] > 0 ? px[1] : 0),
+		.y2 = py[1] > sh ? sh : (py[1] > 0 ? py[1] : 0)
+	};
+
+	return true;
+}
+
+/*
+ * The visible part of a clipped object also depends on the objects it is
+ * clipped against, which can move or resize without the object itself being
+ * affected. Resolve the union of the regions they cover (shallow: the clip
+ * source, deep: every ancestor) so that can be compared between passes.
+ */
+static bool damage_clip(struct rendertarget* tgt,
+	arcan_vobject* elem, float fract, struct agp_region* out)
+{
+	*out = (struct agp_region){0};
+	if (elem->clip == ARCAN_CLIP_OFF)
+		return true;
+
+	arcan_vobject* src = elem->clip == ARCAN_CLIP_SHALLOW ?
+		get_clip_source(elem) : elem->parent;
+
+	while (src && src != &current_context->world){
+		surface_properties sprops = empty_surface();
+		arcan_resolve_vidprop(src, fract, &sprops);
+
+		struct agp_region box;
+		if (!damage_box(tgt, src, &sprops, &box))
+			return false;
+
+		region_merge(out, &box);
+		if (elem->clip == ARCAN_CLIP_SHALLOW)
+			break;
+
+		src = src->parent;
+	}
+
+	return true;
+}
+
+/*
+ * Compare the state of [elem] against the last time it was drawn into [tgt]
+ * and extend the rendertarget damage with the old and new regions on change.
+ */
+static void damage_object(struct rendertarget* tgt,
+	arcan_vobject* elem, surface_properties* dprops, float fract)
+{
+	struct agp_region box, clip;
+	if (!damage_box(tgt, elem, dprops, &box) ||
+		!damage_clip(tgt, elem, fract, &clip)){
+		tgt->damage_full = true;
+		return;
+	}
+
+/* find the slot tracking the object in this rendertarget, or the one that
+ * was least recently drawn to if there isn't one */
+	struct vobj_damage* slot = NULL;
+	bool known = false;
+	for (size_t i = 0; i < COUNT_OF(elem->damage.slot); i++){
+		if (elem->damage.slot[i].tgt == tgt){
+			slot = &elem->damage.slot[i];
+			break;
+		}
+		if (!elem->damage.slot[i].tgt)
+			slot = &elem->damage.slot[i];
+		else
+			known = true;
+	}
+
+/* drawn somewhere else with all slots taken, so there is no knowing where it
+ * was in this rendertarget the last time around */
+	if (!slot){
+		slot = &elem->damage.slot[1];
+		tgt->damage_full = true;
+	}
+	else if (slot->tgt != tgt && known)
+		tgt->damage_full = true;
+
+/* contents of shared stores and rendertarget outputs can change without the
+ * object itself being flagged, atlas pages flag all objects they repack */
+	bool volatile_store = FL_TEST(elem, FL_RTGT) ||
+		(elem->vstore->refcount > 1 && !elem->atlas);
+
+	if (slot->tgt == tgt){
+		if (!volatile_store &&
+			slot->seq == elem->damage.seq &&
+			fabsf(slot->opa - dprops->opa) < EPSILON &&
+			fabsf(slot->roll - dprops->rotation.roll) < EPSILON &&
+			memcmp(&slot->box, &box, sizeof(struct agp_region)) == 0 &&
+			memcmp(&slot->clip, &clip, sizeof(struct agp_region)) == 0)
+			return;
+
+		damage_merge(tgt, &slot->box);
+	}
+
+	damage_merge(tgt, &box);
+
+	*slot = (struct vobj_damage){
+		.tgt = tgt,
+		.box = box,
+		.clip = clip,
+		.seq = elem->damage.seq,
+		.opa = dprops->opa,
+		.roll = dprops->rotation.roll
+	};
+}
+
+/*
+ * The object is no longer drawn into [tgt] (hidden, outside the order range,
+ * ...), so whatever region it covered the last time needs to be damaged.
+ */
+static void damage_drop(struct rendertarget* tgt, arcan_vobject* elem)
+{
+	for (size_t i = 0; i < COUNT_OF(elem->damage.slot); i++){
+		if (elem->damage.slot[i].tgt == tgt){
+			damage_merge(tgt, &elem->damage.slot[i].box);
+			elem->damage.slot[i].tgt = NULL;
+			return;
+		}
+	}
+}
+
+/*
+ * Resolve the damage for the coming pass over [tgt] by comparing the 2D part
+ * of the pipeline against how it was drawn the last time around. This runs
+ * before anything is drawn so that the clear and the draw calls can be
+ * scissored to the result.
+ */
+static void damage_collect(
+	struct rendertarget* tgt, arcan_vobject_litem* current, float fract)
+{
+/* the 3D pipe is not tracked, any part of the store might be affected */
+	if (current && current->elem->order < 0){
+		if (tgt->order3d != ORDER3D_NONE)
+			tgt->damage_full = true;
+
+		while (current && current->elem->order < 0)
+			current = current->next;
+	}
+
+	for (; current && current->elem->order >= 0; current = current->next){
+		arcan_vobject* elem = current->elem;
+
+		if (elem->order < tgt->min_order){
+			damage_drop(tgt, elem);
+			continue;
+		}
+
+		if (elem->order > tgt->max_order)
+			break;
+
+		surface_properties dprops = empty_surface();
+		arcan_resolve_vidprop(elem, fract, &dprops);
+
+		if (dprops.opa <= EPSILON || elem == tgt->color){
+			damage_drop(tgt, elem);
+			continue;
+		}
+
+		damage_object(tgt, elem, &dprops, fract);
+	}
+}
+
+/*
+ * In a scissored pass, objects that were drawn entirely outside of the damaged
+ * region (as of the collection pass) can be skipped altogether.
+ */
+static bool damage_overlaps(struct rendertarget* tgt, arcan_vobject* elem)
+{
+	for (size_t i = 0; i < COUNT_OF(elem->damage.slot); i++){
+		if (elem->damage.slot[i].tgt == tgt){
+			struct agp_region* b = &elem->damage.slot[i].box;
+			struct agp_region* d = &tgt->damage;
+			return b->x1 < d->x2 && b->x2 > d->x1 && b->y1 < d->y2 && b->y2 > d->y1;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * The pass is over, move its damage into the history that displays resolve
+ * partial updates from and into what the next readback needs to cover.
+ */
+static void damage_finish(struct rendertarget* tgt)
+{
+	tgt->damage_hist[tgt->msc % RTGT_DAMAGE_HISTORY] = (struct rtgt_damage){
+		.box = tgt->damage,
+		.full = tgt->damage_full
+	};
+
+	if (tgt->damage_full)
+		tgt->readback_full = true;
+	else
+		region_merge(&tgt->readback_damage, &tgt->damage);
+
+	tgt->damage = (struct agp_region){0};
+	tgt->damage_full = false;
+}
+
+bool arcan_vint_rtdamage(
+	struct rendertarget* tgt, size_t msc, struct agp_region* out)
+{
+	if (!tgt || msc > tgt->msc || tgt->msc - msc > RTGT_DAMAGE_HISTORY)
+		return false;
+
+	*out = (struct agp_region){0};
+	for (size_t i = msc + 1; i <= tgt->msc; i++){
+		struct rtgt_damage* d = &tgt->damage_hist[i % RTGT_DAMAGE_HISTORY];
+		if (d->full)
+			return false;
+
+		region_merge(out, &d->box);
+	}
+
+	return true;
+}
+
+/*
+ * Occlusion culling (TGTFL_CULL) - opaque objects are drawn with blending
+ * disabled, so anything earlier in the same 2D pass that lies completely
+ * inside one of them will be overwritten. The prepass collects the largest
+ * such objects as rendertarget- space rectangles along with their position
+ * in the draw order, and the draw pass then skips everything that is fully
+ * contained in an occluder that comes later.
+ *
+ * Only the default shaders are trusted not to displace vertices, so both
+ * occluders and candidates are limited to those, and to plain 2D transforms.
+ */
+struct occluder {
+	float x1, y1, x2, y2;
+	size_t ind;
+};
+
+static bool occlusion_bounds(struct rendertarget* tgt,
+	arcan_vobject* elem, surface_properties* dprops, float* box, bool* axis)
+{
+	agp_shader_id shid = tgt->shid;
+	if (!tgt->force_shid && elem->program)
+		shid = elem->program;
+
+	if (elem->shape || FL_TEST(elem, FL_FULL3D) ||
+		elem->feed.state.tag == ARCAN_TAG_ASYNCIMGLD ||
+		fabsf(dprops->rotation.pitch) > EPSILON ||
+		fabsf(dprops->rotation.yaw) > EPSILON)
+		return false;
+
+	if (!(elem->vstore->txmapped == TXSTATE_TEX2D &&
+			shid == agp_default_shader(BASIC_2D)) &&
+		!(elem->vstore->txmapped == TXSTATE_OFF &&
+			shid == agp_default_shader(COLOR_2D)))
+		return false;
+
+	float _Alignas(16) scratch[16];
+	surface_properties prop = *dprops;
+	float* m = surf_modelview(tgt, &prop, elem, scratch);
+	if (!affine_2d(m))
+		return false;
+
+/* same corners as agp_draw_vobj */
+	float sx = prop.scale.x;
+	float sy = prop.scale.y;
+	float corners[8] = {-sx, -sy, sx, -sy, sx, sy, -sx, sy};
+
+	box[0] = box[1] = INFINITY;
+	box[2] = box[3] = -INFINITY;
+
+	for (size_t i = 0; i < 4; i++){
+		float x = m[0] * corners[i * 2] + m[4] * corners[i * 2 + 1] + m[12];
+		float y = m[1] * corners[i * 2] + m[5] * corners[i * 2 + 1] + m[13];
+		box[0] = x < box[0] ? x : box[0];
+		box[1] = y < box[1] ? y : box[1];
+		box[2] = x > box[2] ? x : box[2];
+		box[3] = y > box[3] ? y : box[3];
+	}
+
+	*axis = fabsf(m[1]) <= EPSILON && fabsf(m[4]) <= EPSILON;
+	return true;
+}
+
+static size_t occlusion_collect(struct rendertarget* tgt,
+	arcan_vobject_litem* current, float fract, struct occluder* occl)
+{
+	size_t count = 0;
+
+	for (size_t ind = 0; current && current->elem->order >= 0;
+		current = current->next, ind++){
+		arcan_vobject* elem = current->elem;
+
+		if (elem->order < tgt->min_order)
+			continue;
+
+		if (elem->order > tgt->max_order)
+			break;
+
+		surface_properties dprops = empty_surface();
+		arcan_resolve_vidprop(elem, fract, &dprops);
+
+/* a clipped object doesn't cover its full bounds */
+		if (elem == tgt->color || elem->clip != ARCAN_CLIP_OFF ||
+			dprops.opa < 1.0 - EPSILON ||
+			draw_blendmode(elem, &dprops) != BLEND_NONE)
+			continue;
+
+		float box[4];
+		bool axis;
+		if (!occlusion_bounds(tgt, elem, &dprops, box, &axis) || !axis)
+			continue;
+
+		struct occluder cur = {
+			.x1 = box[0], .y1 = box[1], .x2 = box[2], .y2 = box[3], .ind = ind
+		};
+
+		if (count < OCCLUSION_LIMIT){
+			occl[count++] = cur;
+			continue;
+		}
+
+/* full, replace the smallest one if this is larger */
+		float area = (cur.x2 - cur.x1) * (cur.y2 - cur.y1);
+		size_t min = 0;
+		float min_area = INFINITY;
+
+		for (size_t i = 0; i < count; i++){
+			float ca = (occl[i].x2 - occl[i].x1) * (occl[i].y2 - occl[i].y1);
+			if (ca < min_area){
+				min_area = ca;
+				min = i;
+			}
+		}
+
+		if (area > min_area)
+			occl[min] = cur;
+	}
+
+	return count;
+}
+
+static bool occluded(struct rendertarget* tgt, arcan_vobject* elem,
+	surface_properties* dprops, size_t ind, struct occluder* occl, size_t n)
+{
+	float box[4];
+	bool axis;
+
+	if (!n || !occlusion_bounds(tgt, elem, dprops, box, &axis))
+		return false;
+
+	for (size_t i = 0; i < n; i++){
+		if (occl[i].ind > ind &&
+			box[0] >= occl[i].x1 && box[1] >= occl[i].y1 &&
+			box[2] <= occl[i].x2 && box[3] <= occl[i].y2)
+			return true;
+	}
+
+	return false;
+}
+
 _Thread_local static struct rendertarget* current_rendertarget;
 struct rendertarget* arcan_vint_current_rt()
 {
@@ -5270,6 +6936,9 @@ static size_t process_rendertarget(
 		tgt->link = NULL;
 		size_t old_msc = tgt->msc;
 
+/* the output of the linked pass is drawn over in full by this one, so neither
+ * can be limited to the damaged region */
+		tgt->damage_full = true;
 		pc += process_rendertarget(tgt, fract, false);
 		nest = pc > 0;
 
@@ -5279,6 +6948,7 @@ static size_t process_rendertarget(
 		tgt->dirtyc += tgt->link->dirtyc;
 		tgt->transfc += tgt->link->transfc;
 		tgt->msc = old_msc;
+		tgt->damage_full = true;
 	}
 
 	current = tgt->first;
@@ -5294,8 +6964,17 @@ static size_t process_rendertarget(
 		return 0;
 
 	tgt->uploadc = 0;
+	tgt->drawc = 0;
+	tgt->batchc = 0;
+	tgt->cullc = 0;
 	tgt->msc++;
 
+/* invalidations that couldn't be attributed to an object since last pass */
+	if (tgt->damage_gen != arcan_video_display.damage_gen){
+		tgt->damage_gen = arcan_video_display.damage_gen;
+		tgt->damage_full = true;
+	}
+
 /* this does not really swap the stores unless they are actually different, it
  * is cheaper to do it here than shareglstore as the search for vobj to rtgt is
  * expensive */
@@ -5307,12 +6986,46 @@ static size_t process_rendertarget(
 	agp_shader_envv(RTGT_ID, &tgt->id, sizeof(int));
 	agp_shader_envv(OBJ_OPACITY, &(float){1.0}, sizeof(float));
 
+/* Unless something forces a full redraw, limit the clear and the draw calls
+ * to the region that changed. This relies on the store retaining its contents
+ * from the previous pass, which agp knows if it can or not. Accumulating
+ * (NOCLEAR) targets redraw everything every pass by definition. */
+	damage_collect(tgt, current, fract);
+
+	bool partial = false;
+	if (!tgt->damage_full && !nest && !arcan_video_display.ignore_dirty &&
+		!FL_TEST(tgt, TGTFL_NOCLEAR)){
+		partial = agp_rendertarget_scissor(tgt->art, &tgt->damage);
+		tgt->damage_full = !partial;
+	}
+	else
+		tgt->damage_full = true;
+
+/* nothing visible changed so there is nothing to draw, though the cursor is
+ * composed on top of the world by the platform and might still have moved */
+	if (partial &&
+		(tgt->damage.x1 >= tgt->damage.x2 || tgt->damage.y1 >= tgt->damage.y2)){
+		agp_rendertarget_scissor(tgt->art, NULL);
+		damage_finish(tgt);
+
+		if (tgt == &current_context->stdoutp &&
+			arcan_video_display.cursor.vstore &&
+			(arcan_video_display.cursor.x != arcan_video_display.cursor.ox ||
+			arcan_video_display.cursor.y != arcan_video_display.cursor.oy)){
+			tgt->frame_cookie = arcan_video_display.cookie;
+			pc++;
+		}
+
+		return pc;
+	}
+
 	if (!FL_TEST(tgt, TGTFL_NOCLEAR) && !nest)
 		agp_rendertarget_clear();
 
 /* first, handle all 3d work (which may require multiple passes etc.) */
 	if (tgt->order3d == ORDER3D_FIRST && current && current->elem->order < 0){
 		current = arcan_3d_refresh(tgt->camtag, current, fract);
+		tgt->damage_full = true;
 		pc++;
 	}
 
@@ -5329,7 +7042,14 @@ static size_t process_rendertarget(
 	agp_shader_activate(agp_default_shader(BASIC_2D));
 	agp_shader_envv(PROJECTION_MATR, tgt->projection, sizeof(float)*16);
 
-	while (current && current->elem->order >= 0){
+	struct occluder occl[OCCLUSION_LIMIT];
+	size_t n_occl = 0;
+	size_t ind = 0;
+
+	if (FL_TEST(tgt, TGTFL_CULL))
+		n_occl = occlusion_collect(tgt, current, fract, occl);
+
+	for (; current && current->elem->order >= 0; ind++){
 		arcan_vobject* elem = current->elem;
 
 		if (current->elem->order < tgt->min_order){
@@ -5340,6 +7060,11 @@ static size_t process_rendertarget(
 		if (current->elem->order > tgt->max_order)
 			break;
 
+		if (partial && !damage_overlaps(tgt, elem)){
+			current = current->next;
+			continue;
+		}
+
 /* calculate coordinate system translations, world cannot be masked */
 		surface_properties dprops = empty_surface();
 		arcan_resolve_vidprop(elem, fract, &dprops);
@@ -5350,6 +7075,12 @@ static size_t process_rendertarget(
 			continue;
 		}
 
+		if (occluded(tgt, elem, &dprops, ind, occl, n_occl)){
+			tgt->cullc++;
+			current = current->next;
+			continue;
+		}
+
 /* enable clipping using stencil buffer, we need to reset the state of the
  * stencil buffer between draw calls so track if it's enabled or not */
 		bool clipped = false;
@@ -5376,6 +7107,14 @@ static size_t process_rendertarget(
 		agp_shader_id shid = tgt->shid;
 		if (!tgt->force_shid && elem->program)
 			shid = elem->program;
+
+		if (draw_batch_add(tgt, elem, shid, &dprops, txcos)){
+			current = current->next;
+			pc++;
+			continue;
+		}
+
+		draw_batch_flush(tgt);
 		agp_shader_activate(shid);
 
 		if (elem->frameset){
@@ -5421,14 +7160,21 @@ static size_t process_rendertarget(
 
 /* reset and try the 3d part again if requested */
 end3d:
+	draw_batch_flush(tgt);
 	current = tgt->first;
 	if (current && current->elem->order < 0 && tgt->order3d == ORDER3D_LAST){
 		agp_shader_activate(agp_default_shader(BASIC_2D));
 		current = arcan_3d_refresh(tgt->camtag, current, fract);
-		if (current != tgt->first)
+		if (current != tgt->first){
+			tgt->damage_full = true;
 			pc++;
+		}
 	}
 
+	if (partial)
+		agp_rendertarget_scissor(tgt->art, NULL);
+	damage_finish(tgt);
+
 	if (pc){
 		tgt->frame_cookie = arcan_video_display.cookie;
 	}
@@ -5452,6 +7198,10 @@ arcan_errc arcan_video_forceread(
 	if (!vobj || !dstore)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	if (!arcan_vint_atlas_evict(vobj))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+	dstore = vobj->vstore;
+
 	if (dstore->txmapped != TXSTATE_TEX2D)
 		return ARCAN_ERRC_UNACCEPTED_STATE;
 
@@ -5580,6 +7330,7 @@ void arcan_vint_pollreadback(struct rendertarget* tgt)
 	if (!vobj->feed.ffunc)
 		tgt->readback = 0;
 	else{
+		tgt->readback_region = rbb.region;
 		arcan_ffunc_lookup(vobj->feed.ffunc)(
 			FFUNC_READBACK, rbb.ptr, rbb.w * rbb.h * sizeof(av_pixel),
 			rbb.w, rbb.h, 0, vobj->feed.state, vobj->cellid
@@ -5607,6 +7358,17 @@ static size_t steptgt(float fract, struct rendertarget* tgt)
 		return 1;
 	}
 
+/* Only feeding displays that are all still busy presenting the last frame,
+ * defer so that a slower display doesn't get work paced by a faster one. The
+ * dirty state stays and is picked up when any of them frees up. */
+	if (dst && !tgt->readback &&
+		arcan_conductor_display_busy(
+			dst == &current_context->world ? ARCAN_VIDEO_WORLDID : dst->cellid)){
+		TRACE_MARK_ONESHOT("video", "rendertarget-deferred",
+			TRACE_SYS_FAST, 0, 0, dst->tracetag);
+		return 0;
+	}
+
 	size_t transfc = 0;
 	if (tgt->refresh < 0 && process_counter(
 		tgt, &tgt->refreshcnt, tgt->refresh, fract)){
@@ -5621,6 +7383,66 @@ static size_t steptgt(float fract, struct rendertarget* tgt)
 	return transfc;
 }
 
+static void rtgt_visit(size_t ind, uint8_t* mark, uint16_t* order, size_t* n)
+{
+	if (mark[ind])
+		return;
+
+/* 1 marks in progress, reaching it again means a cycle and that edge is
+ * ignored, leaving those in their 'first come first update' order */
+	mark[ind] = 1;
+	uint64_t* deps = current_context->rtargets[ind].deps;
+	for (size_t w = 0; w < RENDERTARGET_DEP_WORDS; w++){
+		uint64_t set = deps[w];
+		while (set){
+			size_t dep = w * 64 + __builtin_ctzll(set);
+			set &= set - 1;
+			rtgt_visit(dep, mark, order, n);
+		}
+	}
+
+	mark[ind] = 2;
+	order[(*n)++] = ind;
+}
+
+static void rtgt_dep(struct rendertarget* tgt, size_t ind)
+{
+	tgt->deps[ind / 64] |= 1ull << (ind % 64);
+}
+
+/*
+ * Build the dependency edges (a rendertarget sampling the color store of
+ * another, or sharing its pipeline through a link) and sort the indices of
+ * rtargets[] into the context rtgt_order so that producers come before their
+ * consumers.
+ */
+static void rtgt_order(struct arcan_video_context* ctx)
+{
+	size_t n_rt = ctx->n_rtargets;
+
+	for (size_t i = 0; i < n_rt; i++){
+		struct rendertarget* tgt = &ctx->rtargets[i];
+		memset(tgt->deps, '\0', sizeof(tgt->deps));
+
+		if (tgt->link && tgt->link != &ctx->stdoutp)
+			rtgt_dep(tgt, tgt->link - ctx->rtargets);
+
+		for (arcan_vobject_litem* cur = tgt->first; cur; cur = cur->next){
+			struct rendertarget* src = arcan_vint_findrt_vstore(cur->elem->vstore);
+			if (src && src != tgt && src != &ctx->stdoutp)
+				rtgt_dep(tgt, src - ctx->rtargets);
+		}
+	}
+
+	uint8_t mark[RENDERTARGET_LIMIT] = {0};
+	size_t n = 0;
+	for (size_t i = 0; i < n_rt; i++)
+		rtgt_visit(i, mark, ctx->rtgt_order, &n);
+
+	ctx->n_rtgt_order = n;
+	ctx->rtgt_order_dirty = false;
+}
+
 unsigned arcan_vint_refresh(float fract, size_t* ndirty)
 {
 	long long int pre = arcan_timemillis();
@@ -5628,12 +7450,19 @@ unsigned arcan_vint_refresh(float fract, size_t* ndirty)
 
 	size_t transfc = 0;
 
+/* regions packed into atlas pages since the last pass */
+	arcan_vint_atlas_flush(current_context);
+
 /* we track last interp. state in order to handle forcerefresh */
 	arcan_video_display.c_lerp = fract;
 	arcan_random((void*)&arcan_video_display.cookie, 8);
 
 /* active shaders with counter counts towards dirty */
-	transfc += agp_shader_envv(FRACT_TIMESTAMP_F, &fract, sizeof(float));
+	size_t nts = agp_shader_envv(FRACT_TIMESTAMP_F, &fract, sizeof(float));
+	if (nts){
+		transfc += nts;
+		arcan_video_display.damage_gen++;
+	}
 
 /* the user/developer or the platform can decide that all dirty tracking should
  * be enabled - we do that with a global counter and then 'fake' a transform */
@@ -5642,13 +7471,14 @@ unsigned arcan_vint_refresh(float fract, size_t* ndirty)
 		arcan_video_display.ignore_dirty--;
 	}
 
-/* Right now there is an explicit 'first come first update' kind of
- * order except for worldid as everything else might be composed there.
- *
- * The opption would be to build the dependency graph between rendertargets
- * and account for cycles, but has so far not shown worth it. */
+/* Rendertargets are processed so that the ones sampled by others go first,
+ * with worldid last as everything else might be composed there. */
+	if (current_context->rtgt_order_dirty)
+		rtgt_order(current_context);
+
 	size_t tgt_dirty = 0;
-	for (size_t ind = 0; ind < current_context->n_rtargets; ind++){
+	for (size_t i = 0; i < current_context->n_rtgt_order; i++){
+		size_t ind = current_context->rtgt_order[i];
 		struct rendertarget* tgt = &current_context->rtargets[ind];
 
 		const char* tag = tgt->color ? tgt->color->tracetag : NULL;
@@ -5806,6 +7636,9 @@ arcan_errc arcan_video_sliceobject(arcan_vobj_id sid,
 	if (!src)
 		return ARCAN_ERRC_NO_SUCH_OBJECT;
 
+	if (!arcan_vint_atlas_evict(src))
+		return ARCAN_ERRC_OUT_OF_SPACE;
+
 	return (agp_slice_vstore(src->vstore, n_slices, base,
 		type == ARCAN_CUBEMAP ? TXSTATE_CUBE : TXSTATE_TEX3D))
 		? ARCAN_OK : ARCAN_ERRC_UNACCEPTED_STATE;
@@ -5821,7 +7654,7 @@ arcan_errc arcan_video_updateslices(
 	struct agp_vstore* vstores[n_slices];
 	for (size_t i = 0; i < sid; i++){
 		arcan_vobject* slot = arcan_video_getobject(slices[i]);
-		if (!slot){
+		if (!slot || !arcan_vint_atlas_evict(slot)){
 			vstores[i] = NULL;
 			continue;
 		}
@@ -5903,8 +7736,11 @@ img_cons arcan_video_storage_properties(arcan_vobj_id id)
 	arcan_vobject* vobj = arcan_video_getobject(id);
 
 	if (vobj && vobj->vstore){
-		res.w = vobj->vstore->w;
-		res.h = vobj->vstore->h;
+		size_t w = vobj->vstore->w;
+		size_t h = vobj->vstore->h;
+		arcan_vint_atlas_dimensions(vobj, &w, &h);
+		res.w = w;
+		res.h = h;
 		res.bpp = vobj->vstore->bpp;
 	}
 
@@ -6202,6 +8038,7 @@ void arcan_video_shutdown(bool release_fsrv)
 		return;
 
 	arcan_video_display.in_video = false;
+	tick_pool_stop();
 
 /* This will effectively make sure that all external launchers, frameservers
  * etc. gets killed off. If we should release frameservers, individually set
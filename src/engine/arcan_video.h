@@ -488,6 +488,14 @@ arcan_vobj_id arcan_video_renderstring(arcan_vobj_id id,
 	struct arcan_rstrarg arg, unsigned int* lines,
 	struct renderline_meta** lineheights, arcan_errc* errc);
 
+/*
+ * Finish an asynchronous image load that a loader thread has completed,
+ * uploading the store and emitting the LOADED / FAILED event. No-op if the
+ * object has already been joined, isn't attached yet or the GPUs are locked,
+ * the tick picks those up instead.
+ */
+void arcan_video_joinasynch(arcan_vobj_id id);
+
 /*
  * Immediately erase the object and all its related resources.
  * Depending on the internal structure of the object in question,
@@ -546,10 +554,12 @@ arcan_errc arcan_video_resizefeed(arcan_vobj_id id, size_t w, size_t h);
  * defined in the resource will be retained, otherwise the image will be
  * rescaled upon loading (unfiltered and rather slow).
  *
- * The asynchronous version will spawn a worker thread (up to a certain
- * number, compile-time limited with ASYNCH_CONCURRENT_THREADS).
- * Context operations will force a join on any outstanding asynchronous
- * loading jobs.
+ * The asynchronous version will queue the job to a pool of worker threads
+ * (spawned on demand up to a certain number, compile-time limited with
+ * ASYNCH_CONCURRENT_THREADS). Jobs for objects that become visible are
+ * prioritized, and jobs that haven't started are dropped if the object is
+ * deleted. Context operations will force a join on any outstanding
+ * asynchronous loading jobs.
  *
  * Loadimage returns ARCAN_EID on failure, asynch will always succeed but
  * may later enqueue EVENT_ASYNCHIMAGE_FAILED or EVENT_VIDEO_ASYNCHIMAGE_LOADED
@@ -566,6 +576,22 @@ arcan_vobj_id arcan_video_loadimage(const char* fname,
  */
 arcan_errc arcan_video_pushasynch(arcan_vobj_id id);
 
+/*
+ * Counters for the asynchronous loader pool, latencies are in milliseconds
+ * from the job being queued until the image has been decoded.
+ */
+struct arcan_video_asynchstats {
+	size_t workers;
+	size_t queued;
+	size_t queued_prio;
+	size_t running;
+	size_t completed;
+	size_t cancelled;
+	unsigned long long latency_avg;
+	unsigned long long latency_max;
+};
+void arcan_video_asynchstats(struct arcan_video_asynchstats* out);
+
 /*
  * By default, all objects share a set of texture coordinates in the form
  * [ul(s,t), ur(s,t), lr(s,t), ll(st)]. When any texture coordinate related
@@ -750,6 +776,14 @@ arcan_errc arcan_video_detachfromrendertarget(arcan_vobj_id did,
 arcan_errc arcan_video_alterreadback(arcan_vobj_id did, int readback);
 arcan_errc arcan_video_rendertarget_setnoclear(arcan_vobj_id did, bool value);
 
+/*
+ * Skip drawing 2D objects that are fully covered by an opaque object drawn
+ * later in the same pass for the rendertarget backing of *did*.
+ * Error codes:
+ *  ARCAN_ERRC_NO_SUCH_OBJECT
+ */
+arcan_errc arcan_video_rendertarget_setcull(arcan_vobj_id did, bool value);
+
 /*
  * Define the range of valid, resolved, order values that will actually be
  * drawn for the rendertarget. A negative number or where max < min will
@@ -822,6 +856,20 @@ arcan_vobj_id arcan_video_findstate(enum arcan_vobj_tags tag, void* ptr);
  */
 arcan_errc arcan_video_mipmapset(arcan_vobj_id id, bool state);
 
+/*
+ * Move the storage of a small, static video object into [state=true] or out
+ * of [state=false] an atlas shared with other such objects in the context.
+ * The object keeps its own texture coordinates, these are rewritten to refer
+ * to its region of the atlas. Operations that need a store of its own (e.g.
+ * sharing, resizing, framesets, texture filter changes) move it back out.
+ *
+ * Error codes:
+ *  ARCAN_ERRC_NO_SUCH_OBJECT
+ *  ARCAN_ERRC_UNACCEPTED_STATE (too large, shared, no local copy, ...)
+ *  ARCAN_ERRC_OUT_OF_SPACE
+ */
+arcan_errc arcan_video_atlasobject(arcan_vobj_id id, bool state);
+
 /*
  * Set the tesselation level for drawing the vobj. This is used when a
  * normal quad is insufficient, which should be almost exclusively the
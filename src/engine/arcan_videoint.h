@@ -16,13 +16,38 @@
 #define RENDERTARGET_LIMIT 64
 #endif
 
+/* words in the per-rendertarget dependency bitset, follows the limit */
+#define RENDERTARGET_DEP_WORDS ((RENDERTARGET_LIMIT + 63) / 64)
+
+/* size of the open addressed rendertarget indices in the context, power of two
+ * and at least twice the limit so that probe sequences stay short */
+#ifndef RENDERTARGET_HASH
+#define RENDERTARGET_HASH 128
+#endif
+
+_Static_assert((RENDERTARGET_HASH & (RENDERTARGET_HASH - 1)) == 0 &&
+	RENDERTARGET_HASH >= 2 * RENDERTARGET_LIMIT,
+	"RENDERTARGET_HASH must be a power of two and >= 2 * RENDERTARGET_LIMIT");
+
+/* number of passes of damage that each rendertarget remembers, needs to cover
+ * the deepest swapchain that partial updates of a mapped display should use */
+#ifndef RTGT_DAMAGE_HISTORY
+#define RTGT_DAMAGE_HISTORY 4
+#endif
+
 struct arcan_vobject_litem;
 struct arcan_vobject;
 
+struct rtgt_damage {
+	struct agp_region box;
+	bool full;
+};
+
 enum rtgt_flags {
 	TGTFL_READING = 1,
 	TGTFL_ALIVE   = 2,
-	TGTFL_NOCLEAR = 4
+	TGTFL_NOCLEAR = 4,
+	TGTFL_CULL    = 8
 };
 
 struct rendertarget {
@@ -50,6 +75,10 @@ struct rendertarget {
 /* identifier for matching against shader */
 	int id;
 
+/* unique for the lifetime of the rendertarget, unlike [id] which the
+ * scripting layer can change, used to key the attachment index */
+	uint64_t attach_key;
+
 /* color representes the attached vid,
  * first is the pipeline (subset of context vid pool) */
 	struct arcan_vobject* color;
@@ -61,6 +90,10 @@ struct rendertarget {
 
 /* corresponding agp backend store for the rendertarget in question */
 	struct agp_rendertarget* art;
+
+/* bitset of the rtargets[] that this one is linked to or samples the color
+ * store of, rebuilt along with the context rtgt_order */
+	uint64_t deps[RENDERTARGET_DEP_WORDS];
 	enum rendertarget_mode mode;
 
 	enum rtgt_flags flags;
@@ -95,6 +128,19 @@ struct rendertarget {
  */
 	size_t uploadc;
 
+/*
+ * 2D draw calls issued during the last pass over the rendertarget, and how
+ * many objects that were merged into batched draws rather than drawn alone.
+ */
+	size_t drawc;
+	size_t batchc;
+
+/*
+ * objects that were skipped during the last pass as they were fully covered
+ * by an opaque object drawn later in the same pass (TGTFL_CULL)
+ */
+	size_t cullc;
+
 /*
  * dirty- management is still incomplete in that dirty- flagging is a global
  * video state and not bound to rendertarget which is in conflict with
@@ -104,6 +150,34 @@ struct rendertarget {
  */
 	size_t dirtyc;
 
+/*
+ * damage accumulated from the bounding boxes of objects that changed since
+ * the last pass, resolved before anything is drawn so that the clear and the
+ * draw calls can be scissored to it. [damage_gen] is compared to the
+ * display-global counter bumped by FLAG_DIRTY(NULL) as such changes can't be
+ * attributed to a region.
+ */
+	struct agp_region damage;
+	size_t damage_gen;
+	bool damage_full;
+
+/*
+ * damage of the last RTGT_DAMAGE_HISTORY passes indexed by [msc], so that
+ * consumers of the store that run at other rates (displays with a different
+ * buffer age) can resolve what changed since they last looked at it.
+ */
+	struct rtgt_damage damage_hist[RTGT_DAMAGE_HISTORY];
+
+/*
+ * damage that has accumulated over the passes since the last readback was
+ * requested, consumed (and reset) by arcan_vint_requestreadback
+ */
+	struct agp_region readback_damage;
+	bool readback_full;
+
+/* region covered by the readback that is currently being delivered */
+	struct agp_region readback_region;
+
 /*
  * track density per rendertarget, this affects some video objects that gets
  * attached in that they are rerasterized to match the properties of the new
@@ -176,6 +250,14 @@ typedef struct surface_transform {
 	struct surface_transform* next;
 } surface_transform;
 
+struct vobj_damage {
+	struct rendertarget* tgt;
+	struct agp_region box;
+	struct agp_region clip;
+	unsigned seq;
+	float opa, roll;
+};
+
 struct frameset_store {
 	struct agp_vstore* frame;
 	float txcos[8];
@@ -236,6 +318,10 @@ typedef struct arcan_vobject {
 	float* txcos;
 	enum arcan_blendfunc blendmode;
 
+/* set if the vstore is a shared atlas page rather than a store of its own,
+ * txcos are then relative to the page, see arcan_vatlas.c */
+	struct vatlas_alloc* atlas;
+
 /* position */
 	signed int order;
 	surface_properties current;
@@ -279,10 +365,23 @@ typedef struct arcan_vobject {
 	struct {
 		signed attachments;
 		signed links;
+
+/* number of rendertarget lists the object is in, attachments above also
+ * counts the objects attached to a rendertarget on its color vobject */
+		signed lists;
 	} extrefc;
 
 	char* tracetag;
 	char* alttext;
+
+/* damage tracking, [seq] is bumped by FLAG_DIRTY(vobj) and each slot keeps
+ * the state the object had when it was last drawn into a rendertarget. Two
+ * slots cover the common case of an object being attached to both the world
+ * and some offscreen rendertarget. */
+	struct {
+		unsigned seq;
+		struct vobj_damage slot[2];
+	} damage;
 } arcan_vobject;
 
 /* regular old- linked list, but also mapped to an array */
@@ -305,6 +404,9 @@ struct arcan_video_display {
 
 	int dirty;
 	size_t ignore_dirty;
+
+/* bumped on invalidations that can't be attributed to a single object */
+	size_t damage_gen;
 	enum arcan_order3d order3d;
 
 /*
@@ -347,21 +449,24 @@ struct arcan_video_display {
 };
 
 /*
- *  Indicate that the video pipeline is in such a state that
- *  it should be redrawn. X should be NULL or a vobj reference
- *  (to permit partial redraws in the future if we need to save
- *  bandwidth).
+ * Objects that have per-tick work pending (transformations, feed function,
+ * frame cycling, lifetime or asynch loading) are tracked in a dense set split
+ * into parallel arrays, so the tick streams through the work flags and ids
+ * rather than through every attachment of every rendertarget.
+ *
+ * [slot] is indexed by cellid and holds (index + 1) into [id] and [work], or
+ * 0 if the object is not tracked. Entries where [work] has dropped to 0 are
+ * compacted away at the end of each tick. [xfer] carries the transformation
+ * state from the (possibly parallel) interpolation pass to the serial pass
+ * that emits events.
  */
-static void _int_flag(struct arcan_vobject* vobj){
-	if (vobj && vobj->owner)
-		vobj->owner->transfc++;
-}
-
-#define FLAG_DIRTY(X) do {_int_flag(X); arcan_video_display.dirty++; } while(0)
-
-#define FL_SET(obj_ptr, fl) ((obj_ptr)->flags |= fl)
-#define FL_CLEAR(obj_ptr, fl) ((obj_ptr)->flags &= ~fl)
-#define FL_TEST(obj_ptr, fl) (( ((obj_ptr)->flags) & (fl)) > 0)
+struct vobject_tickset {
+	size_t count;
+	arcan_vobj_id* id;
+	uint8_t* work;
+	uint8_t* xfer;
+	uint32_t* slot;
+};
 
 /* these all represent a subset of the current context that is to be drawn.  if
  * (dest != NULL) this means that the vid actually represents a rendertarget,
@@ -379,18 +484,55 @@ struct arcan_video_context {
 
 	arcan_vobject world;
 	arcan_vobject* vitems_pool;
+	struct vobject_tickset ticks;
 
 	struct rendertarget rtargets[RENDERTARGET_LIMIT];
 	struct rendertarget* attachment;
 	ssize_t n_rtargets;
 
+/* rtargets[] by color vobject and by color vstore, each slot holds
+ * (index + 1) or 0 if empty, rebuilt whenever rtargets[] is reordered */
+	uint16_t rtgt_byobj[RENDERTARGET_HASH];
+	uint16_t rtgt_bystore[RENDERTARGET_HASH];
+
+/* rtargets[] indices in processing order (producers before consumers), the
+ * dirty flag is set whenever attachments, links or shared stores change */
+	uint16_t rtgt_order[RENDERTARGET_LIMIT];
+	size_t n_rtgt_order;
+	bool rtgt_order_dirty;
+
 	struct rendertarget stdoutp;
+
+/* atlas pages that small static stores in this context have been packed into */
+	struct vatlas_page* atlas;
 };
 
 extern struct arcan_video_context vcontext_stack[];
 extern unsigned vcontext_ind;
 extern struct arcan_video_display arcan_video_display;
 
+/*
+ *  Indicate that the video pipeline is in such a state that
+ *  it should be redrawn. X should be NULL or a vobj reference,
+ *  the latter limits the damage to the region the object covers.
+ */
+static void _int_flag(struct arcan_vobject* vobj){
+	if (!vobj){
+		arcan_video_display.damage_gen++;
+		return;
+	}
+
+	vobj->damage.seq++;
+	if (vobj->owner)
+		vobj->owner->transfc++;
+}
+
+#define FLAG_DIRTY(X) do {_int_flag(X); arcan_video_display.dirty++; } while(0)
+
+#define FL_SET(obj_ptr, fl) ((obj_ptr)->flags |= fl)
+#define FL_CLEAR(obj_ptr, fl) ((obj_ptr)->flags &= ~fl)
+#define FL_TEST(obj_ptr, fl) (( ((obj_ptr)->flags) & (fl)) > 0)
+
 /*
  * Perform a render-pass, set synch to true if we should block Fragment is in
  * the 0..999 range and specifies how far we are towards the next logical tick.
@@ -422,6 +564,22 @@ void arcan_vint_drop_vstore(struct agp_vstore* s);
 /* check if a pending readback is completed, and process it if it is. */
 void arcan_vint_pollreadback(struct rendertarget* rtgt);
 
+/*
+ * queue an asynchronous readback of the color output of [rtgt], limited to
+ * the damage that has accumulated since the previous readback.
+ */
+void arcan_vint_requestreadback(struct rendertarget* rtgt);
+
+/*
+ * resolve the union of the damage from the passes over [rtgt] that came after
+ * pass [msc] (i.e. rtgt->msc at the time the consumer last looked) into
+ * [out], in store coordinates with the origin at the first row. Returns false
+ * if that can't be known, either because the entire store is affected or the
+ * passes reach further back than the history that is kept.
+ */
+bool arcan_vint_rtdamage(
+	struct rendertarget* rtgt, size_t msc, struct agp_region* out);
+
 /*
  * ensure that the video object pointed to by id is attached to the
  * currently active (main) rendergarget
@@ -465,6 +623,53 @@ void arcan_vint_joinasynch(arcan_vobject* img, bool emit, bool force);
 
 void arcan_vint_reraster(arcan_vobject* img, struct rendertarget*);
 
+/*
+ * Atlas management for small static stores (arcan_vatlas.c). Insert moves
+ * the contents of the vstore of [vobj] into a shared page in [ctx] and
+ * rewrites its txcos to match, evict does the reverse and should be called
+ * before anything that needs the store of the object to be its own (resize,
+ * sharing, readback, ...). Both return false if [vobj] is not in a state
+ * where that is possible.
+ */
+bool arcan_vint_atlas_insert(struct arcan_video_context* ctx,
+	arcan_vobject* vobj);
+bool arcan_vint_atlas_evict(arcan_vobject* vobj);
+
+/*
+ * [vobj] is about to be deleted, release its region without restoring a
+ * store, the page reference is still dropped by the caller.
+ */
+void arcan_vint_atlas_release(arcan_vobject* vobj);
+
+/*
+ * [src] holds texture coordinates relative to the original store of [vobj],
+ * update the object mapping to match, returns false if the coordinates can't
+ * be represented inside the atlas region (e.g. would need repeat).
+ */
+bool arcan_vint_atlas_mapping(arcan_vobject* vobj, const float* src);
+
+/*
+ * texture coordinates relative to the original store of [vobj]
+ */
+const float* arcan_vint_atlas_txcos(arcan_vobject* vobj);
+
+/*
+ * dimensions of the region that [vobj] has in its page
+ */
+void arcan_vint_atlas_dimensions(arcan_vobject* vobj, size_t* w, size_t* h);
+
+/*
+ * synch regions of the pages in [ctx] that have been modified since the last
+ * call, called before the pages are used for drawing.
+ */
+void arcan_vint_atlas_flush(struct arcan_video_context* ctx);
+
+/*
+ * context has been pushed or popped, drop or rebuild the GPU side of pages
+ */
+void arcan_vint_atlas_suspend(struct arcan_video_context* ctx);
+void arcan_vint_atlas_resume(struct arcan_video_context* ctx);
+
 /*
  * Figure out what the vid will be for the next object allocated in this
  * context. This function is primarily used to avoid an initialization
@@ -480,6 +685,13 @@ arcan_vobj_id arcan_vint_nextfree();
 struct rendertarget* arcan_vint_findrt(arcan_vobject* vobj);
 struct rendertarget* arcan_vint_findrt_vstore(struct agp_vstore* st);
 
+/*
+ * true if the contents of vobj end up in a readback, either as the color of
+ * a rendertarget with readback or by being drawn into one (directly or
+ * through a rendertarget that links to the one it is attached to)
+ */
+bool arcan_vint_readback_source(arcan_vobject* vobj);
+
 /*
  * used by the video platform layer, assume that agp_vstore points
  * to the backing end of a rendertarget, and draw it to the bound output-rt
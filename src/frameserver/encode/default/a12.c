@@ -257,6 +257,9 @@ static bool decode_args(struct arg_arr* arg, struct dispatch_data* dst)
 		else if (strcasecmp(method, "raw565") == 0){
 			dst->video_cfg.method = VFRAME_METHOD_RAW_RGB565;
 		}
+		else if (strcasecmp(method, "tile") == 0){
+			dst->video_cfg.method = VFRAME_METHOD_TILE_ZSTD;
+		}
 		else if (strcasecmp(method, "dpng") == 0){
 /* no-op, default */
 		}
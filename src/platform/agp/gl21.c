@@ -151,6 +151,9 @@ static void pbo_alloc_read(struct agp_vstore* store)
 		store->w * store->h * store->bpp, NULL, GL_STREAM_COPY);
 	env->bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
 
+/* contents are undefined until the first full readback */
+	store->vinf.text.rb_reset = true;
+
 	verbose_print("allocated %zu*%zu read-pbo",
 		(size_t) store->w, (size_t) store->h);
 }
@@ -174,6 +177,8 @@ static void pbo_alloc_write(struct agp_vstore* store)
 static void rebuild_pbo(struct agp_vstore* s)
 {
 	struct agp_fenv* env = agp_env();
+	agp_glshared_dropring(s);
+
 	if (s->vinf.text.wid){
 		env->delete_buffers(1, &s->vinf.text.wid);
 		pbo_alloc_write(s);
@@ -347,6 +352,125 @@ glBindBuffer(GL_PIXEL_UNPACK_BUFFER, s->vinf.text.wid);
 #endif
 }
 
+/*
+ * Fenced upload ring: AGP_UPLOAD_RING unpack buffers that are cycled through
+ * with a fence after each transfer, so that mapping the next slot doesn't
+ * stall on the transfer from the previous frame still being in flight. Only
+ * the dirty span gets mapped and copied, with the unpack row length / skip
+ * doing the sub-rectangle addressing on the GPU side. Returns false if the
+ * context lacks range mapping or sync objects so the caller can fall back to
+ * the single buffer path.
+ */
+static bool ring_stream(struct agp_vstore* s,
+	av_pixel* buf, struct stream_meta* meta, bool synch)
+{
+	struct agp_fenv* env = agp_env();
+	if (!env->fence_sync || !env->map_buffer_range)
+		return false;
+
+	size_t x1 = 0, y1 = 0, w = s->w, h = s->h;
+	if (meta->dirty){
+		x1 = meta->x1;
+		y1 = meta->y1;
+		w = meta->w;
+		h = meta->h;
+	}
+	if (!w || !h)
+		return true;
+
+	size_t buf_sz = s->w * s->h * sizeof(av_pixel);
+
+/* first free slot starting at the ring position, the fence check has a zero
+ * timeout so it is a pure poll */
+	size_t slot = s->vinf.text.wring_ind;
+	bool found = false;
+	for (size_t i = 0; i < AGP_UPLOAD_RING && !found; i++){
+		size_t ind = (s->vinf.text.wring_ind + i) % AGP_UPLOAD_RING;
+		void* fence = s->vinf.text.wfence[ind];
+		if (!fence){
+			slot = ind;
+			found = true;
+			continue;
+		}
+		GLenum st = env->client_wait_sync(fence, 0, 0);
+		if (st == GL_ALREADY_SIGNALED || st == GL_CONDITION_SATISFIED){
+			env->delete_sync(fence);
+			s->vinf.text.wfence[ind] = NULL;
+			slot = ind;
+			found = true;
+		}
+	}
+
+	agp_activate_vstore(s);
+
+	bool orphan = !found;
+	if (GL_NONE == s->vinf.text.wring[slot]){
+		env->gen_buffers(1, &s->vinf.text.wring[slot]);
+		orphan = true;
+		verbose_print("(%"PRIxPTR") allocate upload slot %zu (%zu*%zu)",
+			(uintptr_t) s, slot, (size_t) s->w, (size_t) s->h);
+	}
+	env->bind_buffer(GL_PIXEL_UNPACK_BUFFER, s->vinf.text.wring[slot]);
+
+/* all slots still in flight, orphan the oldest rather than block on it */
+	if (orphan){
+		env->buffer_data(GL_PIXEL_UNPACK_BUFFER, buf_sz, NULL, GL_STREAM_DRAW);
+		if (s->vinf.text.wfence[slot]){
+			env->delete_sync(s->vinf.text.wfence[slot]);
+			s->vinf.text.wfence[slot] = NULL;
+		}
+	}
+
+	size_t ofs = (y1 * s->w + x1) * sizeof(av_pixel);
+	size_t span = ((h - 1) * s->w + w) * sizeof(av_pixel);
+	uint8_t* dst = env->map_buffer_range(GL_PIXEL_UNPACK_BUFFER, ofs, span,
+		GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+
+	if (!dst){
+		env->bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		agp_deactivate_vstore();
+		verbose_print("(%"PRIxPTR") failed to map upload slot", (uintptr_t) s);
+		return false;
+	}
+
+/* rows keep their natural offsets so the unpack state can address them */
+	size_t row_sz = w * sizeof(av_pixel);
+	size_t pitch = s->w * sizeof(av_pixel);
+	uint8_t* src = (uint8_t*) buf + ofs;
+	for (size_t y = 0; y < h; y++)
+		memcpy(&dst[y * pitch], &src[y * pitch], row_sz);
+
+	env->unmap_buffer(GL_PIXEL_UNPACK_BUFFER);
+
+	struct stream_meta sub = *meta;
+	sub.x1 = x1;
+	sub.y1 = y1;
+	set_pixel_store(s->w, sub);
+	env->tex_subimage_2d(GL_TEXTURE_2D, 0, x1, y1, w, h,
+		s->vinf.text.s_fmt ? s->vinf.text.s_fmt : GL_PIXEL_FORMAT,
+		GL_UNSIGNED_BYTE, 0
+	);
+	reset_pixel_store();
+
+	s->vinf.text.wfence[slot] = env->fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	s->vinf.text.wring_ind = (slot + 1) % AGP_UPLOAD_RING;
+
+	env->bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	agp_deactivate_vstore();
+
+	verbose_print("(%"PRIxPTR") ring upload slot %zu: %zu+%zu*%zu+%zu",
+		(uintptr_t) s, slot, x1, w, y1, h);
+
+	if (synch){
+		av_pixel* cpy = s->vinf.text.raw;
+		for (size_t y = y1; y < y1 + h; y++)
+			memcpy(&cpy[y * s->w + x1], &buf[y * s->w + x1], row_sz);
+		s->update_ts = arcan_timemillis();
+	}
+
+	return true;
+}
+
 static inline void setup_unpack_pbo(struct agp_vstore* s, void* buf)
 {
 	struct agp_fenv* env = agp_env();
@@ -399,6 +523,9 @@ struct stream_meta agp_stream_prepare(struct agp_vstore* s,
 		alloc_buffer(s);
 	case STREAM_RAW_DIRECT:
 		verbose_print("(%"PRIxPTR") prepare upload (raw/direct)", (uintptr_t) s);
+		if (ring_stream(s, meta.buf, &meta, type == STREAM_RAW_DIRECT_COPY))
+			break;
+
 		if (!s->vinf.text.wid)
 			setup_unpack_pbo(s, meta.buf);
 
@@ -527,6 +654,76 @@ void agp_request_readback(struct agp_vstore* store)
 	env->get_tex_image(GL_TEXTURE_2D, 0, GL_PIXEL_FORMAT, GL_UNSIGNED_BYTE, NULL);
 	env->bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
 	env->bind_texture(GL_TEXTURE_2D, 0);
+
+	store->vinf.text.rb_region = (struct agp_region){
+		.x2 = store->w, .y2 = store->h
+	};
+	store->vinf.text.rb_reset = false;
+}
+
+void agp_request_readback_region(
+	struct agp_vstore* store, struct agp_region* region)
+{
+	if (!store || store->txmapped != TXSTATE_TEX2D)
+		return;
+
+	if (!region || !store->vinf.text.rid || store->vinf.text.rb_reset){
+		agp_request_readback(store);
+		return;
+	}
+
+	struct agp_region r = *region;
+	if (r.x2 > store->w)
+		r.x2 = store->w;
+	if (r.y2 > store->h)
+		r.y2 = store->h;
+
+/* nothing has changed, still transfer a token pixel so that the readback
+ * acts as a clock for the consumer */
+	if (r.x1 >= r.x2 || r.y1 >= r.y2)
+		r = (struct agp_region){.x2 = 1, .y2 = 1};
+
+	if (r.x1 == 0 && r.y1 == 0 && r.x2 == store->w && r.y2 == store->h){
+		agp_request_readback(store);
+		return;
+	}
+
+/* there is no subimage variant of getTexImage before 4.5, so go through an
+ * FBO that the store gets temporarily attached to and read into the same
+ * offset in the PBO as a full readback would */
+	struct agp_fenv* env = agp_env();
+	static GLuint rb_fbo;
+	if (!rb_fbo)
+		env->gen_framebuffers(1, &rb_fbo);
+
+	GLint cfbo;
+	env->get_integer_v(GL_DRAW_FRAMEBUFFER_BINDING, &cfbo);
+
+	verbose_print("(%"PRIxPTR":glid %u) readPixels(%zu,%zu-%zu,%zu) => PBO",
+		(uintptr_t) store, (unsigned) store->vinf.text.glid, r.x1, r.y1, r.x2, r.y2);
+
+	env->bind_framebuffer(GL_FRAMEBUFFER, rb_fbo);
+	env->framebuffer_texture_2d(GL_FRAMEBUFFER,
+		GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, agp_resolve_texid(store), 0);
+
+	env->bind_buffer(GL_PIXEL_PACK_BUFFER, store->vinf.text.rid);
+	env->pixel_storei(GL_PACK_ROW_LENGTH, store->w);
+	env->pixel_storei(GL_PACK_SKIP_PIXELS, r.x1);
+	env->pixel_storei(GL_PACK_SKIP_ROWS, r.y1);
+
+	env->read_pixels(r.x1, r.y1, r.x2 - r.x1, r.y2 - r.y1,
+		GL_PIXEL_FORMAT, GL_UNSIGNED_BYTE, NULL);
+
+	env->pixel_storei(GL_PACK_ROW_LENGTH, 0);
+	env->pixel_storei(GL_PACK_SKIP_PIXELS, 0);
+	env->pixel_storei(GL_PACK_SKIP_ROWS, 0);
+	env->bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	env->framebuffer_texture_2d(GL_FRAMEBUFFER,
+		GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+	env->bind_framebuffer(GL_FRAMEBUFFER, cfbo);
+
+	store->vinf.text.rb_region = r;
 }
 
 struct asynch_readback_meta agp_poll_readback(struct agp_vstore* store)
@@ -544,6 +741,7 @@ struct asynch_readback_meta agp_poll_readback(struct agp_vstore* store)
 
 	res.w = store->w;
 	res.h = store->h;
+	res.region = store->vinf.text.rb_region;
 	res.tag = (void*) 0xdeadbeef;
 	res.ptr = (av_pixel*) env->map_buffer(GL_PIXEL_PACK_BUFFER, GL_READ_WRITE);
 
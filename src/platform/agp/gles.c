@@ -208,6 +208,12 @@ void agp_request_readback(struct agp_vstore* store)
 	arcan_warning("agp(gles) - readbacks not supported\n");
 }
 
+void agp_request_readback_region(
+	struct agp_vstore* store, struct agp_region* region)
+{
+	agp_request_readback(store);
+}
+
 struct asynch_readback_meta argp_buffer_readback_asynchronous(
 	struct agp_vstore* dst, bool poll)
 {
@@ -58,6 +58,12 @@ struct agp_fenv {
 	void (*buffer_data) (GLenum, GLsizeiptr, const GLvoid*, GLenum);
 	void (*bind_buffer) (GLenum, GLuint);
 	void* (*map_buffer) (GLenum, GLenum);
+	void* (*map_buffer_range) (GLenum, GLintptr, GLsizeiptr, GLbitfield);
+
+/* Fences, optional (ARB_sync / 3.2+ / GLES3), GLsync is kept opaque */
+	void* (*fence_sync) (GLenum, GLbitfield);
+	GLenum (*client_wait_sync) (void*, GLbitfield, uint64_t);
+	void (*delete_sync) (void*);
 
 /* FBOs */
 	void (*gen_framebuffers) (GLsizei, GLuint*);
@@ -164,4 +170,8 @@ struct agp_fenv {
 
 void agp_glinit_fenv(struct agp_fenv* dst,
 	void*(*lookup)(void* tag, const char* sym, bool req), void* tag);
+
+/* release the PBOs and fences of the streaming upload ring of a store */
+struct agp_vstore;
+void agp_glshared_dropring(struct agp_vstore* s);
 #endif
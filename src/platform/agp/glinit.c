@@ -102,6 +102,25 @@ void agp_glinit_fenv(struct agp_fenv* dst,
 	dst->map_buffer =
 		(void*(*)(GLenum, GLenum))
 			lookup(tag, "glMapBuffer");
+	dst->map_buffer_range =
+		(void*(*)(GLenum, GLintptr, GLsizeiptr, GLbitfield))
+			lookup_opt(tag, "glMapBufferRange");
+
+/* without all of these, streaming uploads fall back to a single PBO */
+	dst->fence_sync =
+		(void*(*)(GLenum, GLbitfield))
+			lookup_opt(tag, "glFenceSync");
+	dst->client_wait_sync =
+		(GLenum(*)(void*, GLbitfield, uint64_t))
+			lookup_opt(tag, "glClientWaitSync");
+	dst->delete_sync =
+		(void(*)(void*))
+			lookup_opt(tag, "glDeleteSync");
+	if (!dst->fence_sync || !dst->client_wait_sync || !dst->delete_sync){
+		dst->fence_sync = NULL;
+		dst->client_wait_sync = NULL;
+		dst->delete_sync = NULL;
+	}
 #endif
 /* FBOs */
 	dst->gen_framebuffers =
@@ -1149,6 +1149,48 @@ void agp_rendertarget_clear()
 	agp_rendertarget_dirty(active_rendertarget, &(struct agp_region){});
 }
 
+bool agp_rendertarget_scissor(
+	struct agp_rendertarget* tgt, struct agp_region* region)
+{
+	struct agp_fenv* env = agp_env();
+	size_t w, h;
+
+/* the display output, the platform knows if the contents is retained */
+	if (!tgt){
+#ifdef HEADLESS_NOARCAN
+		return false;
+#else
+		struct monitor_mode mode = platform_video_dimensions();
+		w = mode.width;
+		h = mode.height;
+		env->scissor(0, 0, w, h);
+		if (!region)
+			return true;
+#endif
+	}
+	else {
+		ssize_t* vp = tgt->viewport;
+		env->scissor(vp[0], vp[1], vp[2], vp[3]);
+		if (!region)
+			return true;
+
+		w = tgt->store->w;
+		h = tgt->store->h;
+		if (tgt->n_stores || tgt->proxy_state ||
+			vp[0] || vp[1] || vp[2] != w || vp[3] != h)
+			return false;
+	}
+
+	size_t x2 = region->x2 > w ? w : region->x2;
+	size_t y2 = region->y2 > h ? h : region->y2;
+	size_t x1 = region->x1 > x2 ? x2 : region->x1;
+	size_t y1 = region->y1 > y2 ? y2 : region->y1;
+
+	verbose_print("scissor: %zu,%zu-%zu,%zu", x1, y1, x2, y2);
+	env->scissor(x1, y1, x2 - x1, y2 - y1);
+	return true;
+}
+
 void agp_pipeline_hint(enum pipeline_mode mode)
 {
 	struct agp_fenv* env = agp_env();
@@ -1207,6 +1249,25 @@ void agp_null_vstore(struct agp_vstore* store)
 		env->delete_buffers(1, &store->vinf.text.wid);
 		store->vinf.text.wid = GL_NONE;
 	}
+#endif
+	agp_glshared_dropring(store);
+}
+
+void agp_glshared_dropring(struct agp_vstore* s)
+{
+#ifndef GLES2
+	struct agp_fenv* env = agp_env();
+	for (size_t i = 0; i < AGP_UPLOAD_RING; i++){
+		if (s->vinf.text.wfence[i]){
+			env->delete_sync(s->vinf.text.wfence[i]);
+			s->vinf.text.wfence[i] = NULL;
+		}
+		if (GL_NONE != s->vinf.text.wring[i]){
+			env->delete_buffers(1, &s->vinf.text.wring[i]);
+			s->vinf.text.wring[i] = GL_NONE;
+		}
+	}
+	s->vinf.text.wring_ind = 0;
 #endif
 }
 
@@ -1578,6 +1639,39 @@ void agp_draw_vobj(
 	agp_rendertarget_dirty(active_rendertarget, &(struct agp_region){});
 }
 
+void agp_draw_vobj_batch(const float* verts, const float* txcos, size_t n)
+{
+	if (!n)
+		return;
+
+	verbose_print("draw-vobj-batch(%zu)", n);
+	struct agp_fenv* env = agp_env();
+
+	agp_shader_envv(MODELVIEW_MATR, ident, sizeof(float) * 16);
+
+	GLint attrindv = agp_shader_vattribute_loc(ATTRIBUTE_VERTEX);
+	GLint attrindt = agp_shader_vattribute_loc(ATTRIBUTE_TEXCORD0);
+
+	if (attrindv != -1){
+		env->enable_vertex_attrarray(attrindv);
+		env->vertex_attrpointer(attrindv, 2, GL_FLOAT, GL_FALSE, 0, verts);
+
+		if (attrindt != -1){
+			env->enable_vertex_attrarray(attrindt);
+			env->vertex_attrpointer(attrindt, 2, GL_FLOAT, GL_FALSE, 0, txcos);
+		}
+
+		env->draw_arrays(GL_TRIANGLES, 0, n * 6);
+
+		if (attrindt != -1)
+			env->disable_vertex_attrarray(attrindt);
+
+		env->disable_vertex_attrarray(attrindv);
+	}
+
+	agp_rendertarget_dirty(active_rendertarget, &(struct agp_region){});
+}
+
 static void toggle_debugstates(float* modelview)
 {
 	struct agp_fenv* env = agp_env();
@@ -1786,6 +1880,7 @@ void agp_drop_vstore(struct agp_vstore* s)
 		s->vinf.text.wid = GL_NONE;
 	}
 #endif
+	agp_glshared_dropring(s);
 
 	verbose_print("dropped (%"PRIxPTR")", (uintptr_t) s);
 	memset(s, '\0', sizeof(struct agp_vstore));
@@ -87,6 +87,10 @@ void agp_request_readback(struct agp_vstore* s)
 {
 }
 
+void agp_request_readback_region(struct agp_vstore* s, struct agp_region* r)
+{
+}
+
 struct asynch_readback_meta agp_poll_readback(struct agp_vstore* t)
 {
 	struct asynch_readback_meta res = {0};
@@ -124,6 +128,12 @@ void agp_rendertarget_clear()
 {
 }
 
+bool agp_rendertarget_scissor(
+	struct agp_rendertarget* tgt, struct agp_region* region)
+{
+	return false;
+}
+
 void agp_pipeline_hint(enum pipeline_mode mode)
 {
 }
@@ -167,6 +177,10 @@ void agp_draw_vobj(
 {
 }
 
+void agp_draw_vobj_batch(const float* verts, const float* txcos, size_t n)
+{
+}
+
 void agp_submit_mesh(struct agp_mesh_store* base, enum agp_mesh_flags fl)
 {
 }
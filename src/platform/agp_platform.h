@@ -285,6 +285,10 @@ struct asynch_readback_meta {
 	size_t h;
 	size_t stride;
 
+/* the part of [ptr] that was updated by the readback, the rest is retained
+ * from earlier readbacks */
+	struct agp_region region;
+
 	void (*release)(void* tag);
 	void* tag;
 };
@@ -302,6 +306,14 @@ struct asynch_readback_meta agp_poll_readback(struct agp_vstore*);
  */
 void agp_request_readback(struct agp_vstore*);
 
+/*
+ * Initiate a new asynchronous readback that only updates [region] of the
+ * readback buffer, the contents outside of the region are retained from
+ * previous readbacks. If the buffer contents are undefined (first readback,
+ * resize, ...) or [region] is NULL, this behaves like agp_request_readback.
+ */
+void agp_request_readback_region(struct agp_vstore*, struct agp_region*);
+
 /*
  * For clipping and similar operations where we want to
  * prepare a mask ("stencil") buffer, this sequence of operations
@@ -330,6 +342,15 @@ void agp_blendstate(enum arcan_blendfunc);
 void agp_draw_vobj(float x1, float y1, float x2, float y2,
 	const float* txcos, const float* modelview);
 
+/*
+ * Draw [n] quads in one call using the currently active vstore and shader with
+ * an identity modelview. [verts] and [txcos] each hold 12 floats per quad, two
+ * triangles of x, y pairs that are already in rendertarget space. This is only
+ * equivalent to individual agp_draw_vobj calls for shaders that don't depend
+ * on per-object uniforms.
+ */
+void agp_draw_vobj_batch(const float* verts, const float* txcos, size_t n);
+
 /*
  * Destination format for rendertargets. Note that we do not currently suport
  * floating point targets and that for some platforms, COLOR_DEPTH will map to
@@ -466,6 +487,18 @@ void agp_rendertarget_dirty_reset(
  */
 void agp_rendertarget_clear();
 
+/*
+ * Limit clearing and drawing into the active rendertarget [tgt] to [region]
+ * (in store coordinates), or reset to the viewport if [region] is NULL.
+ * Returns false and keeps the viewport if the contents of the store isn't
+ * retained between passes (multi-buffered, proxied to the display output or
+ * with a viewport that doesn't cover the store) as a partial redraw would
+ * then leave stale contents behind. With [tgt] set to NULL the display output
+ * is used, and it is up to the platform to know what it contains.
+ */
+bool agp_rendertarget_scissor(
+	struct agp_rendertarget* tgt, struct agp_region* region);
+
 /*
  * change the clear color of the rendertarget from the default RGBA(0,0,0,1)
  */
@@ -54,6 +54,8 @@ typedef EGLBoolean (EGLAPIENTRY* PFNEGLGETCONFIGSPROC)
 	(EGLDisplay, EGLConfig*, EGLint, EGLint*);
 typedef const char* (EGLAPIENTRY* PFNEGLQUERYSTRINGPROC)(EGLDisplay, EGLenum);
 typedef EGLBoolean (EGLAPIENTRY* PFNEGLGETCONFIGATTRIBPROC)(EGLDisplay, EGLConfig, EGLint, EGLint*);
+typedef EGLBoolean (EGLAPIENTRY* PFNEGLQUERYSURFACEPROC)
+	(EGLDisplay, EGLSurface, EGLint, EGLint*);
 
 struct egl_env {
 /* EGLImage */
@@ -74,6 +76,9 @@ struct egl_env {
 	PFNEGLCLIENTWAITSYNCKHRPROC client_wait_synch;
 	PFNEGLDUPNATIVEFENCEFDANDROIDPROC dup_fence_fd;
 
+/* Partial Updates */
+	PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC swap_buffers_with_damage;
+
 /* Basic EGL */
 	PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display;
 	PFNEGLDESTROYSURFACEPROC destroy_surface;
@@ -92,6 +97,7 @@ struct egl_env {
 	PFNEGLQUERYSTRINGPROC query_string;
 	PFNEGLSWAPBUFFERSPROC swap_buffers;
 	PFNEGLSWAPINTERVALPROC swap_interval;
+	PFNEGLQUERYSURFACEPROC query_surface;
 	PFNEGLGETCONFIGATTRIBPROC get_config_attrib;
 };
 
@@ -123,6 +129,13 @@ static void map_eglext_functions(struct egl_env* denv,
 	denv->get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC)
 		lookup(tag, "eglGetPlatformDisplayEXT", false );
 
+/* EGL_KHR_swap_buffers_with_damage / EGL_EXT_swap_buffers_with_damage */
+	denv->swap_buffers_with_damage = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+		lookup(tag, "eglSwapBuffersWithDamageKHR", false);
+	if (!denv->swap_buffers_with_damage)
+		denv->swap_buffers_with_damage = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+			lookup(tag, "eglSwapBuffersWithDamageEXT", false);
+
 /* EGL_EXT_image_dma_buf_import_modifiers */
 	denv->query_dmabuf_modifiers = (PFNEGLQUERYDMABUFMODIFIERSEXTPROC)
 		lookup(tag, "eglQueryDmaBufModifiersEXT", false);
@@ -168,6 +181,8 @@ static void map_egl_functions(struct egl_env* denv,
 		(PFNEGLSWAPBUFFERSPROC) lookup(tag, "eglSwapBuffers", true);
 	denv->swap_interval =
 		(PFNEGLSWAPINTERVALPROC) lookup(tag, "eglSwapInterval", true);
+	denv->query_surface =
+		(PFNEGLQUERYSURFACEPROC) lookup(tag, "eglQuerySurface", true);
 }
 
 #endif
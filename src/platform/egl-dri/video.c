@@ -194,6 +194,10 @@ struct dev_node {
 	bool fb2_modifiers;
 	bool ts_monotonic;
 
+/* EGL_EXT_buffer_age, the contents of the back buffer are known and the
+ * display output can be limited to what changed since */
+	bool buffer_age;
+
 /*
  * method is the key driver for most paths in here, see the M_ enum values
  * above to indicate which of the elements here that are valid.
@@ -334,6 +338,18 @@ struct dispout {
 
 	_Alignas(16) float projection[16];
 	_Alignas(16) float txcos[8];
+
+/* partial updates, [hist] is the window-space region that was composed for
+ * each of the last swaps (newest first), [msc] the pass of the mapped
+ * rendertarget that was composed last and [cursor] where it was drawn, with
+ * [reset] set when the mapping has changed in a way that invalidates all */
+	struct {
+		struct agp_region hist[RTGT_DAMAGE_HISTORY];
+		bool full[RTGT_DAMAGE_HISTORY];
+		size_t msc;
+		struct agp_region cursor;
+		bool reset;
+	} damage;
 	enum blitting_hint hint;
 	enum disp_state state;
 	platform_display_id id;
@@ -1071,6 +1087,7 @@ bool platform_video_set_mode(platform_display_id disp,
 		0, d->display.mode.hdisplay, d->display.mode.vdisplay, 0, 0, 1);
 	d->dispw = d->display.mode.hdisplay;
 	d->disph = d->display.mode.vdisplay;
+	d->damage.reset = true;
 
 /*
  * reset scanout buffers to match new crtc mode
@@ -1688,6 +1705,8 @@ static bool setup_node(struct dev_node* node)
 	const char* extstr =
 		node->eglenv.query_string(node->display, EGL_EXTENSIONS);
 
+	node->buffer_age = check_ext("EGL_EXT_buffer_age", extstr);
+
 	if (check_ext("EGL_IMG_context_priority", extstr)){
 		priority = true;
 		context_attribs[ca_offset++] = EGL_CONTEXT_PRIORITY_LEVEL_IMG;
@@ -2794,6 +2813,8 @@ static void disable_display(struct dispout* d, bool dealloc)
 	}
 
 	debug_print("(%d) trying to disable", (int)d->id);
+	arcan_conductor_display_cancel(d->device->card_id, d->id);
+
 	if (d->buffer.in_flip){
 		debug_print("(%d) flip pending, deferring destruction", (int)d->id);
 		d->buffer.in_destroy = true;
@@ -3366,6 +3387,7 @@ page_flip_handler(
 
 	d->buffer.in_flip = 0;
 	TRACE_MARK_ONESHOT("egl-dri", "flip-ack", TRACE_SYS_DEFAULT, d->id, frame, "flip");
+	arcan_conductor_display_synch(d->device->card_id, d->id, frame);
 	verbose_print("(%d) flip(frame: %u, @ %u.%u)", (int) d->id, frame, sec, usec);
 
 	switch(d->device->buftype){
@@ -3449,10 +3471,10 @@ static bool dirty_displays()
 	return false;
 }
 
-static bool get_pending(bool primary_only)
+static size_t count_pending(bool primary_only)
 {
 	int i = 0;
-	int pending = 0;
+	size_t pending = 0;
 	struct dispout* d;
 
 	while((d = get_display(i++))){
@@ -3461,7 +3483,12 @@ static bool get_pending(bool primary_only)
 		}
 	}
 
-	return pending > 0;
+	return pending;
+}
+
+static bool get_pending(bool primary_only)
+{
+	return count_pending(primary_only) > 0;
 }
 
 /*
@@ -3471,13 +3498,16 @@ static bool get_pending(bool primary_only)
  *
  * Timeout is typically used for shutdown / cleanup operations where
  * normal background processing need to be ignored anyhow.
+ *
+ * With [any] set, return as soon as one of the pending displays is done.
  */
-static void flush_display_events(int timeout, bool yield)
+static void flush_display_events(int timeout, bool yield, bool any)
 {
 	struct dispout* d;
 	verbose_print("flush display events, timeout: %d", timeout);
 
 	unsigned long long start = arcan_timemillis();
+	size_t npend = count_pending(true);
 
 	int period = 4;
 	if (timeout > 0){
@@ -3533,6 +3563,7 @@ static void flush_display_events(int timeout, bool yield)
 	}
 /* 3 possible timeouts: exit directly, wait indefinitely, wait for fixed period */
 	while (timeout != -1 && get_pending(true) &&
+		(!any || count_pending(true) == npend) &&
 		(!timeout || (timeout && arcan_timemillis() - start < timeout)));
 }
 
@@ -3623,7 +3654,7 @@ void platform_video_synch(
 	int i = 0;
 	struct dispout* d;
 	while (egl_dri.destroy_pending){
-		flush_display_events(30, true);
+		flush_display_events(30, true, false);
 		int ind = __builtin_ffsll(egl_dri.destroy_pending) - 1;
 		debug_print("synch, %d - destroy %d", ind);
 		disable_display(&displays[ind], true);
@@ -3634,7 +3665,7 @@ void platform_video_synch(
  * even though it has finished by now. If we don't flush those out, they will
  * skip updating one frame, so do a quick no-yield flush first */
 	if (get_pending(false))
-		flush_display_events(-1, false);
+		flush_display_events(-1, false, false);
 
 /*
  * Rescanning displays is binned to this as well along with a rate limiting
@@ -3690,7 +3721,9 @@ void platform_video_synch(
  * signal.
  */
 		if (get_pending(false) || updated)
-			flush_display_events(clocked ? 16 : 0, true);
+/* with several displays, return as soon as any of them is ready for a new
+ * frame rather than pacing all of them to the slowest one */
+			flush_display_events(clocked ? 16 : 0, true, true);
 	}
 
 /*
@@ -3757,7 +3790,7 @@ void platform_video_shutdown()
 			disable_display(&displays[i], true);
 			debug_print("shutdown (%zu) took %d ms", i, (int)(arcan_timemillis() - start));
 		}
-		flush_display_events(30, false);
+		flush_display_events(30, false, false);
 	} while (egl_dri.destroy_pending && rc-- > 0);
 
 	for (size_t i = 0; i < sizeof(nodes)/sizeof(nodes[0]); i++)
@@ -3821,6 +3854,10 @@ enum dpms_state platform_video_dpms(
 	if (state != out->display.dpms){
 		debug_print("dmps (%d) change to (%d)", (int)disp, state);
 		dpms_set(out, adpms_to_dpms(state));
+
+/* a powered down display won't complete anything that was in flight */
+		if (state != ADPMS_ON)
+			arcan_conductor_display_cancel(out->device->card_id, out->id);
 	}
 
 	out->display.dpms = state;
@@ -4005,6 +4042,7 @@ ssize_t platform_video_map_display_layer(arcan_vobj_id id,
 		(size_t) d->dispx, (size_t) d->dispy, (int) hint);
 
 	d->frame_cookie = 0;
+	d->damage.reset = true;
 	d->display.primary = hint & HINT_FL_PRIMARY;
 	memcpy(d->txcos, txcos, sizeof(float) * 8);
 
@@ -4142,11 +4180,150 @@ static void ensure_in_fence(struct dispout* d)
  */
 }
 
+static void merge_region(struct agp_region* d, struct agp_region* r)
+{
+	if (r->x1 >= r->x2 || r->y1 >= r->y2)
+		return;
+
+	if (d->x1 >= d->x2 || d->y1 >= d->y2){
+		*d = *r;
+		return;
+	}
+
+	d->x1 = r->x1 < d->x1 ? r->x1 : d->x1;
+	d->y1 = r->y1 < d->y1 ? r->y1 : d->y1;
+	d->x2 = r->x2 > d->x2 ? r->x2 : d->x2;
+	d->y2 = r->y2 > d->y2 ? r->y2 : d->y2;
+}
+
+/*
+ * Translate [r] in the store coordinates of [vs] to the window space of the
+ * display, based on the texture coordinates of the mapping. Only axis aligned
+ * mappings that cover the entire output are handled.
+ */
+static bool damage_to_window(struct dispout* d,
+	struct agp_vstore* vs, struct agp_region* r, struct agp_region* out)
+{
+	float* t = d->txcos;
+	*out = (struct agp_region){0};
+
+	if (fabsf(t[1] - t[3]) > EPSILON || fabsf(t[0] - t[6]) > EPSILON ||
+		fabsf(t[2] - t[0]) < EPSILON || fabsf(t[7] - t[1]) < EPSILON ||
+		d->dispw != d->display.mode.hdisplay ||
+		d->disph != d->display.mode.vdisplay || !vs->w || !vs->h)
+		return false;
+
+	if (r->x1 >= r->x2 || r->y1 >= r->y2)
+		return true;
+
+	float w = d->dispw;
+	float h = d->disph;
+	float px[2] = {
+		((float)r->x1 / vs->w - t[0]) / (t[2] - t[0]) * w,
+		((float)r->x2 / vs->w - t[0]) / (t[2] - t[0]) * w
+	};
+
+/* the display projection has its origin in the upper left corner */
+	float py[2] = {
+		h - ((float)r->y1 / vs->h - t[1]) / (t[7] - t[1]) * h,
+		h - ((float)r->y2 / vs->h - t[1]) / (t[7] - t[1]) * h
+	};
+
+	if (px[1] < px[0]){
+		float tmp = px[0]; px[0] = px[1]; px[1] = tmp;
+	}
+	if (py[1] < py[0]){
+		float tmp = py[0]; py[0] = py[1]; py[1] = tmp;
+	}
+
+/* pad with a pixel for filtering when the mapping is scaled */
+	px[0] = floorf(px[0]) - 1.0f;
+	py[0] = floorf(py[0]) - 1.0f;
+	px[1] = ceilf(px[1]) + 1.0f;
+	py[1] = ceilf(py[1]) + 1.0f;
+
+	*out = (struct agp_region){
+		.x1 = px[0] > 0 ? px[0] : 0,
+		.y1 = py[0] > 0 ? py[0] : 0,
+		.x2 = px[1] > w ? w : (px[1] > 0 ? px[1] : 0),
+		.y2 = py[1] > h ? h : (py[1] > 0 ? py[1] : 0)
+	};
+
+	return true;
+}
+
+/*
+ * Resolve the window-space region of [d] that needs to be composed for this
+ * swap, returns false if that is everything. The frame itself covers what
+ * changed in the mapped rendertarget [tgt] since the last swap along with the
+ * old and the new cursor. With a buffer age of n, the back buffer also lacks
+ * what was composed during the n-1 swaps before that.
+ */
+static bool display_damage(struct dispout* d,
+	arcan_vobject* vobj, struct rendertarget* tgt, struct agp_region* out)
+{
+	struct agp_region frame = {0}, delta;
+	bool full = d->damage.reset || !tgt || !tgt->color ||
+		!arcan_vint_rtdamage(tgt, d->damage.msc, &delta) ||
+		!damage_to_window(d, tgt->color->vstore, &delta, &frame);
+
+	if (!full && vobj->vstore == arcan_vint_world() &&
+		arcan_video_display.cursor.vstore){
+		ssize_t x1 = arcan_video_display.cursor.x;
+		ssize_t y1 = arcan_video_display.cursor.y;
+		ssize_t x2 = x1 + (ssize_t) arcan_video_display.cursor.w;
+		ssize_t y2 = y1 + (ssize_t) arcan_video_display.cursor.h;
+		ssize_t h = d->disph;
+
+		struct agp_region cursor = {
+			.x1 = x1 < 0 ? 0 : x1,
+			.x2 = x2 < 0 ? 0 : (x2 > (ssize_t) d->dispw ? d->dispw : x2),
+			.y1 = h - y2 < 0 ? 0 : (h - y2 > h ? h : h - y2),
+			.y2 = h - y1 < 0 ? 0 : (h - y1 > h ? h : h - y1)
+		};
+
+		merge_region(&frame, &d->damage.cursor);
+		merge_region(&frame, &cursor);
+		d->damage.cursor = cursor;
+	}
+
+	d->damage.reset = false;
+	if (tgt)
+		d->damage.msc = tgt->msc;
+
+	memmove(&d->damage.hist[1], &d->damage.hist[0],
+		sizeof(struct agp_region) * (RTGT_DAMAGE_HISTORY - 1));
+	memmove(&d->damage.full[1], &d->damage.full[0],
+		sizeof(bool) * (RTGT_DAMAGE_HISTORY - 1));
+	d->damage.hist[0] = frame;
+	d->damage.full[0] = full;
+
+	if (full || !d->device->buffer_age || !d->buffer.esurf)
+		return false;
+
+	EGLint age = 0;
+	if (!d->device->eglenv.query_surface(d->device->display,
+		d->buffer.esurf, EGL_BUFFER_AGE_EXT, &age) ||
+		age <= 0 || age > RTGT_DAMAGE_HISTORY)
+		return false;
+
+	*out = frame;
+	for (size_t i = 1; i < age; i++){
+		if (d->damage.full[i])
+			return false;
+		merge_region(out, &d->damage.hist[i]);
+	}
+
+	return true;
+}
+
 static enum display_update_state draw_display(struct dispout* d)
 {
 	bool swap_display = true;
 	arcan_vobject* vobj = arcan_video_getobject(d->vid);
 	agp_shader_id shid = agp_default_shader(BASIC_2D);
+	struct agp_region damage;
+	bool partial = false;
 
 	if (!d->buffer.in_dumb_set && d->buffer.dumb.enabled){
 		return UPDATE_SKIP;
@@ -4179,6 +4356,7 @@ static enum display_update_state draw_display(struct dispout* d)
 	if (d->hint == HINT_NONE &&
 		!d->force_compose && sane_direct_vobj(vobj, "rt_swap")){
 		swap_display = false;
+		d->damage.reset = true;
 		goto out;
 	}
 
@@ -4187,6 +4365,7 @@ static enum display_update_state draw_display(struct dispout* d)
  */
 	if (!vobj) {
 		agp_rendertarget_clear();
+		d->damage.reset = true;
 		goto out;
 	}
 	else{
@@ -4200,10 +4379,19 @@ static enum display_update_state draw_display(struct dispout* d)
 	if (d->skip_blit){
 		verbose_print("(%d) skip draw, already composed", (int)d->id);
 		d->skip_blit = false;
+		d->damage.reset = true;
 	}
 
 	else {
 		ensure_in_fence(d);
+
+		partial = display_damage(d, vobj, newtgt, &damage);
+		if (partial){
+			verbose_print("(%d) partial: %zu,%zu-%zu,%zu", (int)d->id,
+				damage.x1, damage.y1, damage.x2, damage.y2);
+			agp_rendertarget_scissor(NULL, &damage);
+		}
+
 		agp_shader_activate(shid);
 		agp_shader_envv(PROJECTION_MATR, d->projection, sizeof(float)*16);
 		agp_rendertarget_clear();
@@ -4227,11 +4415,24 @@ static enum display_update_state draw_display(struct dispout* d)
 	}
 
 	agp_deactivate_vstore();
+	if (partial)
+		agp_rendertarget_scissor(NULL, NULL);
 
 out:
 	if (swap_display){
 		verbose_print("(%d) pre-swap", (int)d->id);
 			ensure_out_fence(d, true);
+
+/* a swap without damage is treated as if all of it changed */
+		if (partial && damage.x1 < damage.x2 && damage.y1 < damage.y2 &&
+			d->device->eglenv.swap_buffers_with_damage){
+			EGLint rect[4] = {
+				damage.x1, damage.y1, damage.x2 - damage.x1, damage.y2 - damage.y1
+			};
+			d->device->eglenv.swap_buffers_with_damage(
+				d->device->display, d->buffer.esurf, rect, 1);
+		}
+		else
 			d->device->eglenv.swap_buffers(d->device->display, d->buffer.esurf);
 		verbose_print("(%d) swapped", (int)d->id);
 		return UPDATE_FLIP;
@@ -4264,14 +4465,10 @@ static bool update_display(struct dispout* d)
 	agp_activate_rendertarget(NULL);
 
 /*
- * Currently we only do binary damage / update tracking in that there are EGL
- * versions for saying 'this region is damaged, update that' to cut down on
- * fillrate/bw. This should likely be added to the agp_ layer as a simple dirty
- * list that the draw_vobj calls append to. Some is prepared for (see
- * agp_rendertarget_dirty), but more is needed in the drawing logic itself.
- *
- * We can also sidestep the EGL bits entirely and simply go with
- * FB_DAMAGE_CLIPS where applicable.
+ * Composition is limited to the damage of the mapped rendertarget when the
+ * buffer age is known (see display_damage) and forwarded to the swap. We can
+ * also sidestep the EGL bits entirely and simply go with FB_DAMAGE_CLIPS
+ * where applicable.
  */
 	enum display_update_state dstate = draw_display(d);
 
@@ -4384,8 +4581,12 @@ static bool update_display(struct dispout* d)
 			if (!new_crtc){
 				uint32_t fl = DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT;
 				d->buffer.cur_fb = next_fb;
-				if (atomic_set_mode(d, fl))
+				if (atomic_set_mode(d, fl)){
 					d->buffer.in_flip = arcan_timemillis();
+					arcan_conductor_display_submit(d->device->card_id, d->id);
+				}
+				else
+					arcan_conductor_display_cancel(d->device->card_id, d->id);
 			}
 		}
 /* LEGACY: */
@@ -4394,12 +4595,14 @@ static bool update_display(struct dispout* d)
 			TRACE_MARK_ONESHOT("egl-dri", "vsynch-req", TRACE_SYS_DEFAULT, d->id, next_fb, "flip");
 			d->buffer.in_flip = arcan_timemillis();
 			d->buffer.cur_fb = next_fb;
+			arcan_conductor_display_submit(d->device->card_id, d->id);
 
 			verbose_print("(%d) in flip", (int)d->id);
 		}
 		else {
 			debug_print("(%d) error scheduling vsynch-flip (%"PRIxPTR":%"PRIxPTR")",
 				(int)d->id, (uintptr_t) d->buffer.cur_fb, (uintptr_t)next_fb);
+			arcan_conductor_display_cancel(d->device->card_id, d->id);
 		}
 	}
 	set_device_context(d->device);
@@ -4423,7 +4626,7 @@ void platform_video_prepare_external()
 		for(size_t i = 0; i < MAX_DISPLAYS; i++)
 			disable_display(&displays[i], false);
 		if (egl_dri.destroy_pending)
-			flush_display_events(30, false);
+			flush_display_events(30, false, false);
 	} while(egl_dri.destroy_pending && rc-- > 0);
 
 /* tell the privsep side that we no-longer need the GPU */
@@ -243,6 +243,11 @@ struct drm_hdr_meta {
 	float fll;
 };
 
+/* number of buffers used for streaming uploads to a store, see agp_stream_prepare */
+#ifndef AGP_UPLOAD_RING
+#define AGP_UPLOAD_RING 3
+#endif
+
 struct agp_vstore;
 struct agp_vstore {
 	size_t refcount;
@@ -258,6 +263,17 @@ struct agp_vstore {
 /* used for PBO transfers */
 			unsigned rid, wid;
 
+/* multi-buffered streaming uploads, each PBO in [wring] has the fence that
+ * was set after the last texture update that sourced from it in [wfence] */
+			unsigned wring[AGP_UPLOAD_RING];
+			void* wfence[AGP_UPLOAD_RING];
+			uint8_t wring_ind;
+
+/* region covered by the last requested readback, the rest of the read PBO
+ * retains the contents of earlier readbacks unless [rb_reset] is set */
+			struct agp_region rb_region;
+			bool rb_reset;
+
 /* intermediate storage for reconstructing lost context */
 			uint32_t s_raw;
 			av_pixel*  raw;
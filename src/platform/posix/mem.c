@@ -103,6 +103,10 @@ struct mempool_meta {
  *   - few allocations (should correlate to number of threads)
  *   - assumed shorter life-span
  *   - guard pages separate each allocation
+ *
+ * ARCAN_MEM_TRANSFORM =>
+ *   - few, never released, blocks that the video layer splits into
+ *     transformation steps, similar to VSTRUCT in access pattern
  */
 
 int system_page_size = 4096;
@@ -172,6 +176,7 @@ void* arcan_alloc_mem(size_t nb,
 	case ARCAN_MEM_ABUFFER:
 	case ARCAN_MEM_MODELDATA:
 	case ARCAN_MEM_VSTRUCT:
+	case ARCAN_MEM_TRANSFORM:
 	case ARCAN_MEM_EXTSTRUCT:
 	case ARCAN_MEM_STRINGBUF:
 	case ARCAN_MEM_VTAG:
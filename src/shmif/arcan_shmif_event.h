@@ -1025,7 +1025,9 @@ enum ARCAN_TARGET_SKIPMODE {
 		EVENT_VIDEO_DISPLAY_REMOVED,
 		EVENT_VIDEO_DISPLAY_CHANGED,
 		EVENT_VIDEO_ASYNCHIMAGE_LOADED,
-		EVENT_VIDEO_ASYNCHIMAGE_FAILED
+		EVENT_VIDEO_ASYNCHIMAGE_FAILED,
+/* loader thread -> main, consumed in event_feed */
+		EVENT_VIDEO_ASYNCHIMAGE_READY
 	};
 
 	enum ARCAN_EVENT_SYSTEM {